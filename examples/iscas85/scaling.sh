@@ -0,0 +1,27 @@
+#!/bin/bash
+#
+# Time building the BDDs of a circuit with 1, 2, 4, ... threads up to
+# the number of processors, or the given maximum. Other options are
+# passed to iscas.
+#
+# Usage: scaling.sh <file> [<max threads> [<iscas option>*]]
+
+if [ $# -lt 1 ]; then
+	echo "Usage: $0 <file> [<max threads> [<iscas option>*]]" 1>&2
+	exit 1
+fi
+
+iscas=$(dirname "$0")/src/iscas
+file=$1
+max=${2:-$(nproc)}
+shift
+[ $# -gt 0 ] && shift
+
+TIMEFORMAT="%R"
+base=
+for ((threads = 1; threads <= max; threads *= 2)); do
+	secs=$( { time "$iscas" -t $threads "$@" "$file" > /dev/null; } 2>&1 )
+	base=${base:-$secs}
+	awk -v t=$threads -v s=$secs -v b=$base \
+	    'BEGIN { printf "%3d threads: %8.2fs  speedup %5.2f\n", t, s, b / s }'
+done
@@ -6,10 +6,14 @@
 #include "Ckt.h"
 #include "Ticker.h"
 
+#include <BddImage.h>
+
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <optional>
 
 using std::cin;
 using std::cout;
@@ -216,14 +220,20 @@ Ckt::sortByRank()
 
 
 //      Function : Ckt::buildBdds
-//      Abstract : Build bdds for each element.
+//      Abstract : Build bdds for each element. The progress bar is
+//      shown if progress is set.
 void
-Ckt::buildBdds()
+Ckt::buildBdds(bool progress)
 {
-  Ticker ticker(_outputs.size());
+  std::optional<Ticker> ticker;
+  if (progress) {
+    ticker.emplace(_outputs.size());
+  } // if
   for (auto id : _outputs) {
     Bdd bdd = buildBdd(id);
-    ticker.tick();
+    if (ticker) {
+      ticker->tick();
+    } // if
   } // for
 } // Ckt::buildBdds
 
@@ -282,8 +292,7 @@ Ckt::buildBdd(ElId id)
 Bdd
 Ckt::buildInputBdd(Element &el)
 {
-  static BddLit nextLit = 1;
-  auto bdd = _mgr.getLit(nextLit++);
+  auto bdd = _mgr.getLit(_nextLit++);
   el.setBdd(bdd);
 
   return bdd;
@@ -539,3 +548,175 @@ Ckt::printSizes()
 } // Ckt::printSizes
 
 
+//      Function : Ckt::quantify
+//      Abstract : Existentially quantify every other input from each
+//      output, once with exists() and once by expanding each variable
+//      with two restricts and an or, and print the time of each.
+void
+Ckt::quantify()
+{
+  Bdd cube = _mgr.getOne();
+  BddVec vars;
+  for (size_t pos = 0; pos < _inputs.size(); pos += 2) {
+    Bdd var = _elements[_inputs[pos]].getBdd();
+    cube *= var;
+    vars.push_back(var);
+  } // for every other input
+
+  using Clock = std::chrono::steady_clock;
+  using Secs = std::chrono::duration<double>;
+  BddVec quantified;
+  auto start = Clock::now();
+  for (auto id : _outputs) {
+    quantified.push_back(_elements[id].getBdd().exists(cube));
+  } // for each output
+  double existsSecs = Secs(Clock::now() - start).count();
+
+  bool same = true;
+  start = Clock::now();
+  for (size_t pos = 0; pos < _outputs.size(); ++pos) {
+    Bdd f = _elements[_outputs[pos]].getBdd();
+    for (auto &var : vars) {
+      f = f/var + f/~var;
+    } // for each variable
+    same = same && (f == quantified[pos]);
+  } // for each output
+  double expandSecs = Secs(Clock::now() - start).count();
+
+  cout << "Quantified " << vars.size() << " of "
+       << _inputs.size() << " inputs." << endl
+       << "exists()        : " << existsSecs << " s" << endl
+       << "Expansion       : " << expandSecs << " s" << endl
+       << "Results " << (same ? "agree." : "DIFFER.") << endl << endl;
+} // Ckt::quantify
+
+
+//      Function : Ckt::rewire
+//      Abstract : Drive every other input of each output by the xor of
+//      its neighbours, once with vectorCompose() and once with a chain
+//      of compose() calls, and print the time of each. The neighbours
+//      are not replaced, so both give the same result.
+void
+Ckt::rewire()
+{
+  BddVarMap subst;
+  for (size_t pos = 0; pos + 1 < _inputs.size(); pos += 2) {
+    Bdd var = _elements[_inputs[pos]].getBdd();
+    Bdd next = _elements[_inputs[pos + 1]].getBdd();
+    Bdd prev = pos > 0 ? _elements[_inputs[pos - 1]].getBdd() : next;
+    subst[var.getTopVar()] = prev ^ next;
+  } // for every other input
+
+  using Clock = std::chrono::steady_clock;
+  using Secs = std::chrono::duration<double>;
+  BddVec outputs;
+  for (auto id : _outputs) {
+    outputs.push_back(_elements[id].getBdd());
+  } // for each output
+  auto start = Clock::now();
+  BddVec rewired = _mgr.vectorCompose(outputs, subst);
+  double vectorSecs = Secs(Clock::now() - start).count();
+
+  bool same = true;
+  start = Clock::now();
+  for (size_t pos = 0; pos < _outputs.size(); ++pos) {
+    Bdd f = _elements[_outputs[pos]].getBdd();
+    for (const auto &[var, g] : subst) {
+      f = f.compose(var, g);
+    } // for each variable
+    same = same && (f == rewired[pos]);
+  } // for each output
+  double chainSecs = Secs(Clock::now() - start).count();
+
+  cout << "Rewired " << subst.size() << " of "
+       << _inputs.size() << " inputs." << endl
+       << "vectorCompose() : " << vectorSecs << " s" << endl
+       << "compose() chain : " << chainSecs << " s" << endl
+       << "Results " << (same ? "agree." : "DIFFER.") << endl << endl;
+} // Ckt::rewire
+
+
+//      Function : Ckt::makeLatches
+//      Abstract : Make a sequential circuit by feeding each of the
+//      first numLatches outputs back to the input in the same position
+//      through a latch. The inputs become the current state variables
+//      and a new variable is made for the next state of each. The
+//      transition relation is the conjunction of parts.
+void
+Ckt::makeLatches(size_t numLatches,
+                 BddVec &parts,
+                 BddVarVec &curVars,
+                 BddVarVec &nextVars)
+{
+  numLatches = std::min({numLatches, _inputs.size(), _outputs.size()});
+  for (size_t pos = 0; pos < numLatches; ++pos) {
+    Bdd cur = _elements[_inputs[pos]].getBdd();
+    Bdd next = _mgr.getLit(_nextLit++);
+    curVars.push_back(cur.getTopVar());
+    nextVars.push_back(next.getTopVar());
+    parts.push_back(next.xnor2(_elements[_outputs[pos]].getBdd()));
+  } // for each latch
+} // Ckt::makeLatches
+
+
+//      Function : Ckt::image
+//      Abstract : Make a sequential circuit with numLatches latches
+//      and find the states reachable from the one with every latch at
+//      zero, once with BddImage::reach() and once by taking the image
+//      of every state reached with the monolithic transition relation,
+//      and print the time of each.
+void
+Ckt::image(size_t numLatches, size_t clusterSz)
+{
+  BddVec parts;
+  BddVarVec curVars;
+  BddVarVec nextVars;
+  makeLatches(numLatches, parts, curVars, nextVars);
+  Bdd init = _mgr.getOne();
+  for (BddVar var : curVars) {
+    init *= ~_mgr.getLit(var);
+  } // for each latch
+
+  using Clock = std::chrono::steady_clock;
+  using Secs = std::chrono::duration<double>;
+  auto start = Clock::now();
+  BddImage img(_mgr, parts, curVars, nextVars, clusterSz);
+  size_t numClusters = img.numClusters();
+  double schedSecs = Secs(Clock::now() - start).count();
+  BddReachSteps steps;
+  Bdd reached = img.reach(init, BddReachOpts(), &steps);
+  size_t peakNodes = 0;
+  for (const auto &step : steps) {
+    peakNodes = std::max(peakNodes, step.peakNodes);
+  } // for each step
+  double partSecs = Secs(Clock::now() - start).count();
+
+  start = Clock::now();
+  Bdd T = _mgr.conjoin(parts);
+  Bdd cube = _mgr.getOne();
+  for (auto id : _inputs) {
+    cube *= _elements[id].getBdd();
+  } // for each input
+  Bdd monoReached = init;
+  for (Bdd prev; monoReached != prev; ) {
+    prev = monoReached;
+    Bdd to = _mgr.andExists(monoReached, T, cube);
+    monoReached += _mgr.swapVariables(to, curVars, nextVars);
+  } // for each step
+  double monoSecs = Secs(Clock::now() - start).count();
+
+  cout << "Latches         : " << curVars.size() << endl
+       << "Steps           : " << steps.size() << endl
+       << "Peak nodes      : " << peakNodes << endl
+       << "Reached nodes   : " << reached.countNodes() << endl
+       << "Clusters        : " << numClusters << " of "
+       << img.clusterNodes() << " nodes" << endl
+       << "Relation nodes  : " << T.countNodes() << endl
+       << "Schedule        : " << schedSecs << " s" << endl
+       << "Partitioned     : " << partSecs << " s" << endl
+       << "Monolithic      : " << monoSecs << " s" << endl
+       << "Results " << (reached == monoReached ? "agree." : "DIFFER.")
+       << endl << endl;
+} // Ckt::image
+
+
@@ -17,8 +17,10 @@
 //      Abstract : Class for holding a combinational circuit.
 class Ckt {
 public:
-  Ckt(bool reorder) :
+  Ckt(bool reorder, const BddConfig &config = BddConfig()) :
+    _mgr(0, 0, 0, config),
     _maxRank(-1),
+    _nextLit(1),
     _reorder(reorder),
     _reorderSz(1<<16)
   {}; // CTOR
@@ -30,8 +32,11 @@ public:
   Ckt &operator=(Ckt &&) = delete; // Move assignment
 
   bool parse(std::string &filename);
-  void buildBdds();
+  void buildBdds(bool progress = true);
   void printSizes();
+  void quantify();
+  void rewire();
+  void image(size_t numLatches, size_t clusterSz);
   void printStats() { _mgr.printStats(); };
 
   bool readOrder(std::string &filename);
@@ -60,6 +65,10 @@ private:
   Bdd buildXnorBdd(Element &el);
 
   void tryReorder(bool verbose);
+  void makeLatches(size_t numLatches,
+                   BddVec &parts,
+                   BddVarVec &curVars,
+                   BddVarVec &nextVars);
 
   // Private data elements.
   BddMgr _mgr;
@@ -69,6 +78,7 @@ private:
   ElIdVec _inputs;
   ElIdVec _outputs;
   int _maxRank;
+  BddLit _nextLit;
 
   bool _reorder;
   unsigned int _reorderSz;
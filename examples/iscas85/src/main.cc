@@ -4,8 +4,16 @@
 //
 #include "Ckt.h"
 
+#include <BddImage.h>
+
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
 #include <unistd.h>
 
 using std::cin;
@@ -29,6 +37,38 @@ where <option> is one of the following:
 -R <file>	Use <file> to generate an initial variable ordering.
 
 -W <file>	Write the final variable ordering to <file>.
+
+-L <layout>	Node layout: banked (default) or flat, and joined
+		(default) or split node records. May be given twice,
+		e.g. -L flat -L split.
+
+-M <mode>	Node memory: heap (default), mmap or huge.
+
+-U <mode>	Unique tables: open (default) or chained.
+
+-l		Disable region-local node allocation.
+
+-i		Resize unique tables incrementally.
+
+-t <num>	Share large operations among <num> threads.
+
+-j <num>	Build the circuit in <num> managers at once, one thread
+		each, and report the throughput.
+
+-e		Quantify every other input from each output with
+		exists() and by expanding each variable, and report the
+		time of each.
+
+-c		Drive every other input by the xor of its neighbours
+		with vectorCompose() and with a chain of compose() calls,
+		and report the time of each.
+
+-s <num>	Feed the first <num> outputs back to the inputs through
+		latches and find the states reachable from all zeroes
+		with a partitioned and a monolithic transition relation.
+
+-C <num>	Bound clusters of the partitioned relation to <num>
+		nodes.
 )"
 
        << endl;
@@ -37,6 +77,69 @@ where <option> is one of the following:
 
 
 
+//      Function : runJobs
+//      Abstract : Build the circuit in numJobs independent managers at
+//      once, one thread each, and report the throughput. The page
+//      faults and context switches of the process hint at how much
+//      the threads contend for the memory allocator.
+int
+runJobs(size_t numJobs,
+        std::string &filename,
+        std::string &readVarFn,
+        bool reorder,
+        const BddConfig &config)
+{
+  std::vector<std::unique_ptr<Ckt>> ckts;
+  for (size_t job = 0; job < numJobs; ++job) {
+    ckts.push_back(std::make_unique<Ckt>(reorder, config));
+    if (! ckts.back()->parse(filename)) {
+      cout << "Error: could not parse file \""
+           << filename << "\"." << endl;
+      return 1;
+    } // if
+    ckts.back()->readOrder(readVarFn);
+  } // for each job
+
+  cout << "Processing ..." << endl;
+  using Clock = std::chrono::steady_clock;
+  using Secs = std::chrono::duration<double>;
+  std::vector<double> secs(numJobs);
+  struct rusage before, after;
+  getrusage(RUSAGE_SELF, &before);
+  auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (size_t job = 0; job < numJobs; ++job) {
+    threads.emplace_back([&ckts, &secs, job] {
+      auto jobStart = Clock::now();
+      ckts[job]->buildBdds(false);
+      secs[job] = Secs(Clock::now() - jobStart).count();
+    });
+  } // for each job
+  for (auto &thread : threads) {
+    thread.join();
+  } // for each thread
+  double wall = Secs(Clock::now() - start).count();
+  getrusage(RUSAGE_SELF, &after);
+
+  ckts[0]->printSizes();
+  double mean = 0.0;
+  for (double s : secs) {
+    mean += s / numJobs;
+  } // for each job
+  cout << "Managers        : " << numJobs << endl
+       << "Wall time       : " << wall << " s" << endl
+       << "Mean build time : " << mean << " s" << endl
+       << "Slowest build   : "
+       << *std::max_element(secs.begin(), secs.end()) << " s" << endl
+       << "Throughput      : " << numJobs / wall << " circuits/s" << endl
+       << "Minor faults    : " << after.ru_minflt - before.ru_minflt << endl
+       << "Vol. switches   : " << after.ru_nvcsw - before.ru_nvcsw << endl
+       << "Invol. switches : " << after.ru_nivcsw - before.ru_nivcsw << endl;
+
+  return 0;
+} // runJobs
+
+
 //      Function : main
 //      Abstract : Driver
 int
@@ -45,9 +148,15 @@ main(int argc, char *argv[])
   bool reorder = false;
   std::string readVarFn;
   std::string writeVarFn;
+  BddConfig config;
+  size_t numJobs = 0;
+  bool quantify = false;
+  bool rewire = false;
+  size_t numLatches = 0;
+  size_t clusterSz = BddImage::DFLT_CLUSTER_SZ;
 
   int c;
-  while((c = getopt(argc, argv, "hrR:W:")) != -1) {
+  while((c = getopt(argc, argv, "hrR:W:L:M:U:lit:j:ecs:C:")) != -1) {
     switch (c) {
      case 'h':
       usage();
@@ -62,6 +171,66 @@ main(int argc, char *argv[])
      case 'W':
       writeVarFn = optarg;
       break;
+     case 'L':
+      if (std::string(optarg) == "flat") {
+        config.layout = LAYOUT_FLAT;
+      } else if (std::string(optarg) == "banked") {
+        config.layout = LAYOUT_BANKED;
+      } else if (std::string(optarg) == "split") {
+        config.nodeStore = STORE_SPLIT;
+      } else if (std::string(optarg) == "joined") {
+        config.nodeStore = STORE_JOINED;
+      } else {
+        usage();
+        return 1;
+      } // if
+      break;
+     case 'M':
+      if (std::string(optarg) == "heap") {
+        config.memMode = MEM_HEAP;
+      } else if (std::string(optarg) == "mmap") {
+        config.memMode = MEM_MMAP;
+      } else if (std::string(optarg) == "huge") {
+        config.memMode = MEM_HUGE;
+      } else {
+        usage();
+        return 1;
+      } // if
+      break;
+     case 'U':
+      if (std::string(optarg) == "open") {
+        config.uniqMode = UNIQ_OPEN;
+      } else if (std::string(optarg) == "chained") {
+        config.uniqMode = UNIQ_CHAINED;
+      } else {
+        usage();
+        return 1;
+      } // if
+      break;
+     case 'l':
+      config.localAlloc = false;
+      break;
+     case 'i':
+      config.incrUniq = true;
+      break;
+     case 't':
+      config.threads = std::stoul(optarg);
+      break;
+     case 'j':
+      numJobs = std::stoul(optarg);
+      break;
+     case 'e':
+      quantify = true;
+      break;
+     case 'c':
+      rewire = true;
+      break;
+     case 's':
+      numLatches = std::stoul(optarg);
+      break;
+     case 'C':
+      clusterSz = std::stoul(optarg);
+      break;
      default:
       usage();
       return 1;
@@ -74,7 +243,11 @@ main(int argc, char *argv[])
   } // if
 
   std::string filename(argv[optind]);
-  Ckt ckt(reorder);
+  if (numJobs > 0) {
+    return runJobs(numJobs, filename, readVarFn, reorder, config);
+  } // if
+
+  Ckt ckt(reorder, config);
   if (! ckt.parse(filename)) {
     cout << "Error: could not parse file \""
 	 << filename << "\"." << endl;
@@ -85,6 +258,15 @@ main(int argc, char *argv[])
   ckt.readOrder(readVarFn);
   ckt.buildBdds();
   ckt.printSizes();
+  if (quantify) {
+    ckt.quantify();
+  } // if
+  if (rewire) {
+    ckt.rewire();
+  } // if
+  if (numLatches > 0) {
+    ckt.image(numLatches, clusterSz);
+  } // if
   ckt.writeOrder(writeVarFn);
   ckt.printStats();
 
@@ -0,0 +1,31 @@
+#!/bin/bash
+#
+# Build a circuit in 1, 2, 4, ... independent managers at once, one
+# thread each, up to the number of processors or the given maximum.
+# Other options are passed to iscas. Scaling is the throughput over
+# that of one manager; with no contention it equals the number of
+# managers.
+#
+# Usage: throughput.sh <file> [<max managers> [<iscas option>*]]
+
+if [ $# -lt 1 ]; then
+	echo "Usage: $0 <file> [<max managers> [<iscas option>*]]" 1>&2
+	exit 1
+fi
+
+iscas=$(dirname "$0")/src/iscas
+file=$1
+max=${2:-$(nproc)}
+shift
+[ $# -gt 0 ] && shift
+
+base=
+for ((jobs = 1; jobs <= max; jobs *= 2)); do
+	out=$("$iscas" -j $jobs "$@" "$file")
+	rate=$(echo "$out" | awk '/^Throughput/ { print $3 }')
+	faults=$(echo "$out" | awk '/^Minor faults/ { print $4 }')
+	switches=$(echo "$out" | awk '/^Vol. switches/ { print $4 }')
+	base=${base:-$rate}
+	awk -v j=$jobs -v r=$rate -v b=$base -v f=$faults -v s=$switches \
+	    'BEGIN { printf "%3d managers: %8.3f circuits/s  scaling %5.2f  faults %9d  switches %7d\n", j, r, r / b, f, s }'
+done
@@ -107,11 +107,7 @@ QueensSolver::placeQueens()
 {
   cout << "Adding one queen to each row." << endl;
   for (int row = 0; row < _numQs; ++row) {
-    Bdd inRow = _mgr.getZero();
-    for (int col = 0; col < _numQs; ++col) {
-      inRow += _vars[row][col];
-    } // col
-    _queens *= inRow;
+    _queens *= _mgr.disjoin(BddVec(_vars[row], _vars[row] + _numQs));
   } // for
 } // QueensSolver::placeQueens
 
@@ -145,7 +141,7 @@ QueensSolver::addConstraints(const int row, const int col)
   colConstr = addColumnConstraints(row, col);
   diagConstr = addDiagonalConstraints(row, col);
 
-  _queens *= rowConstr * colConstr * diagConstr;
+  _queens *= _mgr.conjoin({rowConstr, colConstr, diagConstr});
 } // QueensSolver::addConstraints
 
 
@@ -154,15 +150,15 @@ QueensSolver::addConstraints(const int row, const int col)
 Bdd
 QueensSolver::addRowConstraints(const int row, const int col)
 {
-  Bdd constr = _mgr.getOne();
+  BddVec constr;
   Bdd me = _vars[row][col];
   for (int c = 0; c < _numQs; ++c) {
     if (col != c) {
-      constr *= me.implies(~_vars[row][c]);
+      constr.push_back(me.implies(~_vars[row][c]));
     } // if
   } // for
 
-  return constr;
+  return _mgr.conjoin(constr);
 } // QueensSolver::addRowConstraints
 
 
@@ -172,15 +168,15 @@ QueensSolver::addRowConstraints(const int row, const int col)
 Bdd
 QueensSolver::addColumnConstraints(const int row, const int col)
 {
-  Bdd constr = _mgr.getOne();
+  BddVec constr;
   Bdd me = _vars[row][col];
   for (int r = 0; r < _numQs; ++r) {
     if (row != r) {
-      constr *= me.implies(~_vars[r][col]);
+      constr.push_back(me.implies(~_vars[r][col]));
     } // if
   } // for
 
-  return constr;
+  return _mgr.conjoin(constr);
 } // QueensSolver::addColumnConstraints
 
 
@@ -190,14 +186,14 @@ QueensSolver::addColumnConstraints(const int row, const int col)
 Bdd
 QueensSolver::addDiagonalConstraints(const int row, const int col)
 {
-  Bdd constr = _mgr.getOne();
+  BddVec constr;
   Bdd me = _vars[row][col];
 
   // No other queens in down diagonal.
   for (int c = 0; c < _numQs; ++c) {
     int r = row - col + c;
     if (r >= 0 && r < _numQs && row != r) {
-      constr *= me.implies(~_vars[r][c]);
+      constr.push_back(me.implies(~_vars[r][c]));
     } // if
   } // if
 
@@ -205,11 +201,11 @@ QueensSolver::addDiagonalConstraints(const int row, const int col)
   for (int c = 0; c < _numQs; ++c) {
     int r = row + col - c;
     if (r >= 0 && r < _numQs && col != c) {
-      constr *= me.implies(~_vars[r][c]);
+      constr.push_back(me.implies(~_vars[r][c]));
     } // if
   } // for
 
-  return constr;
+  return _mgr.conjoin(constr);
 } // QueensSolver::addDiagonalConstraints
 
 
@@ -243,7 +239,9 @@ QueensSolver::printResults()
   if (_queens.isZero()) {
     cout << _numQs <<"-Queens is UNSAT"  << endl;
   } else {
-    cout << _numQs <<"-Queens is SAT"  << endl << endl;
+    cout << _numQs <<"-Queens is SAT with "
+         << _queens.satCountStr(_numQs * _numQs) << " solutions"
+         << endl << endl;
     std::vector< std::vector<int> > grid;
     grid.resize(_numQs);
     for (auto &row : grid) {
@@ -12,6 +12,7 @@
 using namespace abide;
 
 #include <fstream>
+#include <string>
 #include <sys/stat.h>
 
 using std::cin;
@@ -363,15 +364,15 @@ void
 Sudoku::buildRowConstraints(int row)
 {
   for (int val = 0; val < _N; ++val) {
-    Bdd rowConstraint = _mgr.getOne();
+    BddVec rowConstraint;
     for (int col1 = 0; col1 < _N-1; ++col1) {
       Bdd var1 = entryToVar(row, col1, val);
       for (int col2 = col1+1; col2 < _N; ++col2) {
         Bdd var2 = entryToVar(row, col2, val);
-        rowConstraint *= var1.nand2(var2);
+        rowConstraint.push_back(var1.nand2(var2));
       } // for column 2
     } // for column 1
-    _solution *= rowConstraint;
+    _solution *= _mgr.conjoin(rowConstraint);
   } // for each value
 } // Sudoku::buildRowConstraints
 
@@ -383,15 +384,15 @@ void
 Sudoku::buildColConstraints(int col)
 {
   for (int val = 0; val < _N; ++val) {
-    Bdd colConstraint = _mgr.getOne();
+    BddVec colConstraint;
     for (int row1 = 0; row1 < _N-1; ++row1) {
       Bdd var1 = entryToVar(row1, col, val);
       for (int row2 = row1+1; row2 < _N; ++row2) {
         Bdd var2 = entryToVar(row2, col, val);
-        colConstraint *= var1.nand2(var2);
+        colConstraint.push_back(var1.nand2(var2));
       } // for row 2
     } // for row 1
-    _solution *= colConstraint;
+    _solution *= _mgr.conjoin(colConstraint);
   } // for each value
 } // Sudoku::buildColConstraints
 
@@ -416,7 +417,7 @@ Sudoku::buildBoxConstraints(int row, int col, int val)
   int row0 = row;
   int col0 = col;
 
-  Bdd boxConstraint = _mgr.getOne();
+  BddVec boxConstraint;
   for (int cell1 = 0; cell1 < _N-1; ++cell1) {
     auto [row1, col1] = unpackCell(cell1);
     Bdd var1 = entryToVar(row0+row1, col0+col1, val);
@@ -424,11 +425,11 @@ Sudoku::buildBoxConstraints(int row, int col, int val)
     for (int cell2 = cell1+1; cell2 < _N; ++cell2) {
       auto [row2, col2] = unpackCell(cell2);
       Bdd var2 = entryToVar(row0+row2, col0+col2, val);
-      boxConstraint *= var1.nand2(var2);
+      boxConstraint.push_back(var1.nand2(var2));
     } // for
   } // for
 
-  _solution *= boxConstraint;
+  _solution *= _mgr.conjoin(boxConstraint);
 } // Sudoku::buildBoxConstraints
 
 
@@ -439,12 +440,11 @@ Sudoku::buildCellConstraints()
 {
   for (int row = 0; row < _N; ++row) {
     for (int col = 0; col < _N; ++col) {
-      Bdd cellConstraint = _mgr.getZero();
+      BddVec cellConstraint;
       for (int val = 0; val < _N; ++val) {
-        Bdd var = entryToVar(row, col, val);
-        cellConstraint += var;
+        cellConstraint.push_back(entryToVar(row, col, val));
       } // for
-      _solution *= cellConstraint;
+      _solution *= _mgr.disjoin(cellConstraint);
     } // for each column
   } // for each row
 } // Sudoku::buildCellConstraints
@@ -515,17 +515,20 @@ Sudoku::unpackCell(int c)
 void
 Sudoku::printSolutions()
 {
-  Bdd cube = _solution.oneCube();
+  // Each cell has exactly one value, so every variable is set in a
+  // solution and the count of the set is the number of solutions.
+  std::string total = _solution.satCountStr(_N * _N * _N);
 
   cout << endl;
-  if (cube != _solution) {
-    cout << "Puzzle has multiple solutions.\n" << endl;
-  } else if (cube.isZero()) {
+  if (total == "0") {
     cout << BOLD << RED << "Puzzle has no solutions." << NORMAL << endl;
     return;
+  } else if (total != "1") {
+    cout << "Puzzle has " << total << " solutions.\n" << endl;
   } // if
 
   int numSolutions = 0;
+  Bdd cube = _solution.oneCube();
   while (!cube.isZero() && numSolutions < MAX_SOLUTIONS) {
     printSolution(cube);
     _solution *= (~cube);
@@ -534,13 +537,9 @@ Sudoku::printSolutions()
     ++numSolutions;
   } // while
 
-  if (numSolutions > 1) {
-    if (!cube.isZero() && numSolutions >= MAX_SOLUTIONS) {
-      cout << "Printed " << numSolutions << " solutions.";
-    } else {
-      cout << "Found " << numSolutions << " solutions.";
-    } // if
-    cout << endl;
+  if (!cube.isZero()) {
+    cout << "Printed " << numSolutions << " of " << total << " solutions."
+         << endl;
   } // if
 } // Sudoku::printSolutions
 
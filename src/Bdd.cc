@@ -5,7 +5,9 @@
 
 #include <Bdd.h>
 #include <BddImpl.h>
+#include <algorithm>
 #include <climits>
+#include <iterator>
 
 namespace abide {
 
@@ -40,16 +42,30 @@ BddMgr::BddMgr(size_t numVars,
 //      if more variables are requested. maxNodes is the maximum
 //      number of nodes allowed. This number may be exceeded during
 //      variable reordering but will be below at completion. All other
-//      operations should respect this. cacheSz is the size the size
-//      of the various computed caches. If it is not a power of 2,
-//      then it will be increased to the next power of two.
+//      operations should respect this. cacheSz is the initial
+//      number of entries in the computed cache which is shared by all
+//      operations. If it is not a power of 2, then it will be
+//      increased to the next power of two. The cache is allocated on
+//      first use and grows as the hit rate warrants. See
+//      setCacheRatio().
 BddMgr::BddMgr(size_t numVars,
                size_t maxNodes,
-               size_t cacheSz)
+               size_t cacheSz) : BddMgr(numVars, maxNodes, cacheSz, BddConfig())
+{
+} // BddMgr::BddMgr
+
+
+//      Function : BddMgr::BddMgr
+//      Abstract : Constructor. As above with config selecting the
+//      memory, node layout and table strategies. See BddConfig.
+BddMgr::BddMgr(size_t numVars,
+               size_t maxNodes,
+               size_t cacheSz,
+               const BddConfig &config)
 {
   maxNodes = maxNodes ? maxNodes : DFLT_NODE_SZ;
   cacheSz = cacheSz ? cacheSz : DFLT_CACHE_SZ;
-  _impl = std::make_unique<BddImpl>(numVars, maxNodes, cacheSz);
+  _impl = std::make_unique<BddImpl>(numVars, maxNodes, cacheSz, config);
 } // BddMgr::BddMgr
 
 
@@ -156,6 +172,31 @@ BddMgr::reorder(bool verbose) const
 } // BddMgr::reorder
 
 
+//      Function : BddMgr::reset
+//      Abstract : Free every node so the manager can be reused as if
+//      new, while keeping the memory it has already allocated. All
+//      Bdds of the manager must have been destroyed first. Returns
+//      false and does nothing otherwise.
+bool
+BddMgr::reset()
+{
+  return _impl->reset();
+} // BddMgr::reset
+
+
+//      Function : BddMgr::compact
+//      Abstract : Collect garbage and then move nodes into the lower
+//      node banks so the upper ones can be returned to the
+//      system. Nodes held by Bdds do not move, so a bank holding one
+//      is kept. Returns the number of node slots released.
+size_t
+BddMgr::compact(bool verbose) const
+{
+  _impl->gc(true, verbose);
+  return _impl->compact(verbose);
+} // BddMgr::compact
+
+
 //      Function : BddMgr::getVarOrder
 //      Abstract : Return the ordering of the current BddVars
 const BddVarVec &
@@ -192,6 +233,27 @@ BddMgr::nodesAllocd() const
 } // BddMgr::nodesAllocd
 
 
+//      Function : BddMgr::peakNodes
+//      Abstract : Return the most nodes allocated at once, dead or
+//      alive, since the manager was made or resetPeakNodes() was
+//      called. Nodes made inside an operation are included.
+size_t
+BddMgr::peakNodes() const
+{
+  return _impl->maxAllocd();
+} // BddMgr::peakNodes
+
+
+//      Function : BddMgr::resetPeakNodes
+//      Abstract : Start measuring peakNodes() again from the nodes
+//      allocated now.
+void
+BddMgr::resetPeakNodes() const
+{
+  _impl->resetMaxAllocd();
+} // BddMgr::resetPeakNodes
+
+
 //      Function : BddMgr::varsCreated
 //      Abstract : Return the number of variables created.
 size_t
@@ -211,6 +273,53 @@ BddMgr::setMaxNodes(size_t maxNodes)
 } // BddMgr::setMaxNodes
 
 
+//      Function : BddMgr::setCacheRatio
+//      Abstract : Set the limit on the size of the computed cache as a
+//      multiple of the memory used by nodes. The cache grows toward
+//      this limit when its hit rate shows it is worth it. It also
+//      shrinks after a garbage collection frees most nodes.
+void
+BddMgr::setCacheRatio(double ratio)
+{
+  _impl->setCacheRatio(ratio);
+} // BddMgr::setCacheRatio
+
+
+//      Function : BddMgr::setAutoCompact
+//      Abstract : When set, a garbage collection that leaves most of
+//      the node memory free is followed by compact(). Off by default.
+void
+BddMgr::setAutoCompact(bool b)
+{
+  _impl->setAutoCompact(b);
+} // BddMgr::setAutoCompact
+
+
+//      Function : BddMgr::setBreadthFirst
+//      Abstract : An operation of the Bdd operators that misses the
+//      computed cache threshold times is finished a level at a time
+//      instead of depth first. The results found by then stay in the
+//      cache and are reused. Working a level at a time touches node
+//      memory and the unique tables in long runs, which pays once the
+//      BDDs are much larger than the processor caches, but it needs
+//      memory for every pending operation at once. 0 turns it off.
+//      The default is 64K.
+void
+BddMgr::setBreadthFirst(size_t threshold)
+{
+  _impl->setBreadthFirst(threshold);
+} // BddMgr::setBreadthFirst
+
+
+//      Function : BddMgr::cacheSize
+//      Abstract : Return the number of entries in the computed cache.
+size_t
+BddMgr::cacheSize() const
+{
+  return _impl->cacheSize();
+} // BddMgr::cacheSize
+
+
 //      Function : BddMgr::isOne
 //      Abstract : Return true if the bdd is the one function.
 bool
@@ -344,6 +453,88 @@ BddMgr::andExists(const BDD f, const BDD g, const BDD c) const
 } // BddMgr::andExists
 
 
+//      Function : BddMgr::applyExists
+//      Abstract : Parameters f and g are arbitrary functions and c is
+//      a product of positive literals. The result is Exists(c, f op
+//      g), computed without building f op g.
+Bdd
+BddMgr::applyExists(const Bdd f, const Bdd g, const Bdd c, BddOp op) const
+{
+  Bdd rtn(_impl->applyExists(f._me, g._me, c._me, op), this);
+  _impl->gc(false, false);
+  return rtn;
+} // BddMgr::applyExists
+
+
+//      Function : BddMgr::exists
+//      Abstract : Parameter c is a product of positive literals. The
+//      result is f with the variables of c existentially quantified.
+Bdd
+BddMgr::exists(const Bdd f, const Bdd c) const
+{
+  return exists(f._me, c._me);
+} // BddMgr::exists
+
+
+//      Function : BddMgr::exists
+//      Abstract : Parameter c is a product of positive literals. The
+//      result is f with the variables of c existentially quantified.
+Bdd
+BddMgr::exists(const BDD f, const BDD c) const
+{
+  Bdd rtn(_impl->exists(f, c), this);
+  _impl->gc(false, false);
+  return rtn;
+} // BddMgr::exists
+
+
+//      Function : BddMgr::forall
+//      Abstract : Parameter c is a product of positive literals. The
+//      result is f with the variables of c universally quantified.
+Bdd
+BddMgr::forall(const Bdd f, const Bdd c) const
+{
+  return forall(f._me, c._me);
+} // BddMgr::forall
+
+
+//      Function : BddMgr::forall
+//      Abstract : Parameter c is a product of positive literals. The
+//      result is f with the variables of c universally quantified.
+Bdd
+BddMgr::forall(const BDD f, const BDD c) const
+{
+  Bdd rtn(_impl->forall(f, c), this);
+  _impl->gc(false, false);
+  return rtn;
+} // BddMgr::forall
+
+
+//      Function : BddMgr::unique
+//      Abstract : Parameter c is a product of positive literals. The
+//      result is the Boolean difference of f with respect to each
+//      variable of c, f/x ^ f/~x for one variable x. It is zero if a
+//      variable of c is not in the support of f.
+Bdd
+BddMgr::unique(const Bdd f, const Bdd c) const
+{
+  return unique(f._me, c._me);
+} // BddMgr::unique
+
+
+//      Function : BddMgr::unique
+//      Abstract : Parameter c is a product of positive literals. The
+//      result is the Boolean difference of f with respect to each
+//      variable of c.
+Bdd
+BddMgr::unique(const BDD f, const BDD c) const
+{
+  Bdd rtn(_impl->unique(f, c), this);
+  _impl->gc(false, false);
+  return rtn;
+} // BddMgr::unique
+
+
 //      Function : BddMgr::ite
 //      Abstract : External access to ite() function. Might be useful,
 //      but mostly for unit testing.
@@ -356,6 +547,310 @@ BddMgr::ite(const Bdd f, const Bdd g, const Bdd h) const
 } // BddMgr::ite
 
 
+//      Function : BddMgr::vectorCompose
+//      Abstract : Replace each variable x of subst with subst[x] in f
+//      at once, so that a replacement is not itself changed by the
+//      others. It is one pass over f, rather than one per variable as
+//      with a chain of compose() calls.
+Bdd
+BddMgr::vectorCompose(const Bdd f, const BddVarMap &subst) const
+{
+  return vectorCompose(BddVec{f}, subst)[0];
+} // BddMgr::vectorCompose
+
+
+//      Function : BddMgr::vectorCompose
+//      Abstract : Replace each variable x of subst with subst[x] in
+//      each of fs at once. The BDDs share the work done on their
+//      common nodes.
+BddVec
+BddMgr::vectorCompose(const BddVec &fs, const BddVarMap &subst) const
+{
+  std::map<BddVar, BDD> bdds;
+  for (const auto &[var, g] : subst) {
+    assert(g._mgr == nullptr || g._mgr == this);
+    bdds[var] = g._me;
+  } // for each replacement
+  BDDVec inputs;
+  for (const auto &f : fs) {
+    assert(f._mgr == nullptr || f._mgr == this);
+    inputs.push_back(f._me);
+  } // for each BDD
+
+  BDDVec results = _impl->vectorCompose(inputs, bdds);
+  BddVec rtn;
+  for (BDD r : results) {
+    rtn.push_back(Bdd(r, this));
+  } // for each result
+  _impl->gc(false, false);
+  return rtn;
+} // BddMgr::vectorCompose
+
+
+//      Function : BddMgr::permute
+//      Abstract : Rename each variable x of f to perm[x]. Variables
+//      past the end of perm are kept and perm[0] is unused. Renamed
+//      variables which keep their relative order are relabelled node
+//      by node without calling ite(). See BddImpl::vectorCompose().
+Bdd
+BddMgr::permute(const Bdd f, const BddVarVec &perm) const
+{
+  BddVarMap subst;
+  for (BddVar x = 1; x < perm.size(); ++x) {
+    if (perm[x] != x) {
+      subst[x] = getLit(perm[x]);
+    } // if renamed
+  } // for each variable
+
+  return vectorCompose(f, subst);
+} // BddMgr::permute
+
+
+//      Function : BddMgr::swapVariables
+//      Abstract : Swap each variable xs[i] of f with ys[i], such as
+//      the current and next state variables of a transition relation.
+Bdd
+BddMgr::swapVariables(const Bdd f,
+                      const BddVarVec &xs,
+                      const BddVarVec &ys) const
+{
+  assert(xs.size() == ys.size());
+  BddVarMap subst;
+  for (size_t i = 0; i < xs.size(); ++i) {
+    subst[xs[i]] = getLit(ys[i]);
+    subst[ys[i]] = getLit(xs[i]);
+  } // for each pair
+
+  return vectorCompose(f, subst);
+} // BddMgr::swapVariables
+
+
+//      Function : BddMgr::transfer
+//      Abstract : Copy f, which may belong to another manager, into
+//      this one. Variables are matched by id, so the copy is the same
+//      function whatever the two variable orders.
+Bdd
+BddMgr::transfer(const Bdd &f) const
+{
+  return transfer(BddVec{f})[0];
+} // BddMgr::transfer
+
+
+//      Function : BddMgr::transfer
+//      Abstract : Copy the BDDs fs, which may belong to other managers,
+//      into this one. The nodes the BDDs of a manager share are copied
+//      once. An invalid BDD, or one that could not be copied, gives an
+//      invalid one.
+BddVec
+BddMgr::transfer(const BddVec &fs) const
+{
+  BddVec rtn(fs.size());
+  std::vector<bool> done(fs.size(), false);
+  for (size_t i = 0; i < fs.size(); ++i) {
+    const BddMgr *src = fs[i]._mgr;
+    if (done[i] || src == nullptr) {
+      continue;
+    } // if
+
+    std::vector<size_t> which;
+    BDDVec bdds;
+    for (size_t j = i; j < fs.size(); ++j) {
+      if (!done[j] && fs[j]._mgr == src) {
+        which.push_back(j);
+        bdds.push_back(fs[j]._me);
+        done[j] = true;
+      } // if same manager
+    } // for rest
+    BDDVec copies = (src == this
+                     ? bdds
+                     : _impl->transfer(*src->_impl, bdds));
+    for (size_t k = 0; k < which.size(); ++k) {
+      rtn[which[k]] = Bdd(copies[k], this);
+    } // for each copy
+  } // for each BDD
+  _impl->gc(false, false);
+
+  return rtn;
+} // BddMgr::transfer
+
+
+//      Function : BddMgr::conjoin
+//      Abstract : Returns the conjunction of fs, which is the
+//      recommended way to build a system of constraints. The operands
+//      are combined two at a time so that the intermediate results
+//      stay small: the smallest is conjoined with the one whose support
+//      overlaps its own the most, relative to the union of the two, or
+//      the smallest of those that overlap as much. Operands are
+//      released as soon as they are used. Returns an invalid BDD if an
+//      operand is invalid or the manager runs out of nodes.
+Bdd
+BddMgr::conjoin(const BddVec &fs) const
+{
+  struct Operand {
+    size_t _size;
+    Bdd _f;
+    BddVarVec _supp;
+  }; // Operand
+  auto make = [](Bdd f) {
+    BddVarVec supp = f.supportVec();
+    std::sort(supp.begin(), supp.end());
+    return Operand{f.countNodes(), std::move(f), std::move(supp)};
+  }; // make
+
+  std::vector<Operand> ops;
+  for (const auto &f : fs) {
+    if (!f.valid() || f.isZero()) {
+      return f.valid() ? f : Bdd();
+    } else if (!f.isOne()) {
+      ops.push_back(make(f));
+    } // if
+  } // for each operand
+
+  while (ops.size() > 1) {
+    size_t first = 0;
+    for (size_t k = 1; k < ops.size(); ++k) {
+      if (ops[k]._size < ops[first]._size) {
+        first = k;
+      } // if
+    } // for each operand
+    const BddVarVec &supp = ops[first]._supp;
+
+    size_t best = ops.size();
+    double bestOverlap = -1.0;
+    for (size_t k = 0; k < ops.size(); ++k) {
+      if (k == first) {
+        continue;
+      } // if
+      BddVarVec shared;
+      std::set_intersection(supp.begin(), supp.end(),
+                            ops[k]._supp.begin(), ops[k]._supp.end(),
+                            std::back_inserter(shared));
+      size_t joint = supp.size() + ops[k]._supp.size() - shared.size();
+      double overlap = joint ? double(shared.size()) / joint : 0.0;
+      if (overlap > bestOverlap
+          || (overlap == bestOverlap && ops[k]._size < ops[best]._size)) {
+        best = k;
+        bestOverlap = overlap;
+      } // if better partner
+    } // for each candidate
+
+    Bdd rtn = ops[first]._f * ops[best]._f;
+    ops[first] = std::move(ops.back());
+    ops.pop_back();
+    if (best == ops.size()) {
+      best = first;
+    } // if best was moved
+    ops[best] = std::move(ops.back());
+    ops.pop_back();
+    if (!rtn.valid() || rtn.isZero()) {
+      return rtn;
+    } else if (!rtn.isOne()) {
+      ops.push_back(make(std::move(rtn)));
+    } // if
+  } // while
+
+  return ops.empty() ? getOne() : ops[0]._f;
+} // BddMgr::conjoin
+
+
+//      Function : BddMgr::disjoin
+//      Abstract : Returns the disjunction of fs, scheduled as by
+//      conjoin().
+Bdd
+BddMgr::disjoin(const BddVec &fs) const
+{
+  BddVec inv;
+  for (const auto &f : fs) {
+    inv.push_back(f.valid() ? ~f : f);
+  } // for each operand
+
+  Bdd rtn = conjoin(inv);
+  return rtn.valid() ? ~rtn : rtn;
+} // BddMgr::disjoin
+
+
+//      Function : BddMgr::satCount
+//      Abstract : Return the number of assignments to nvars variables
+//      that satisfy f as a double. The variables must include the
+//      support of f, otherwise the count is zero.
+double
+BddMgr::satCount(const Bdd &f, size_t nvars) const
+{
+  return satCount(BddVec{f}, nvars)[0];
+} // BddMgr::satCount
+
+
+//      Function : BddMgr::satCount128
+//      Abstract : Return the number of assignments to nvars variables
+//      that satisfy f as a 128-bit integer. Counts of 2^128 or more
+//      saturate at the largest value. The variables must include the
+//      support of f, otherwise the count is zero.
+BddCount128
+BddMgr::satCount128(const Bdd &f, size_t nvars) const
+{
+  return satCount128(BddVec{f}, nvars)[0];
+} // BddMgr::satCount128
+
+
+//      Function : BddMgr::satCountStr
+//      Abstract : Return the exact number of assignments to nvars
+//      variables that satisfy f in decimal. The variables must include
+//      the support of f, otherwise the count is zero.
+std::string
+BddMgr::satCountStr(const Bdd &f, size_t nvars) const
+{
+  return satCountStr(BddVec{f}, nvars)[0];
+} // BddMgr::satCountStr
+
+
+//      Function : BddMgr::satCount
+//      Abstract : Return the satCount() of each of fs. Nodes the
+//      functions share are counted once.
+std::vector<double>
+BddMgr::satCount(const BddVec &fs, size_t nvars) const
+{
+  BDDVec v;
+  for (const auto &f : fs) {
+    assert(f._mgr == nullptr || f._mgr == this);
+    v.push_back(f._me);
+  } // for each function
+
+  return _impl->satCount(v, nvars);
+} // BddMgr::satCount
+
+
+//      Function : BddMgr::satCount128
+//      Abstract : Return the satCount128() of each of fs. Nodes the
+//      functions share are counted once.
+std::vector<BddCount128>
+BddMgr::satCount128(const BddVec &fs, size_t nvars) const
+{
+  BDDVec v;
+  for (const auto &f : fs) {
+    assert(f._mgr == nullptr || f._mgr == this);
+    v.push_back(f._me);
+  } // for each function
+
+  return _impl->satCount128(v, nvars);
+} // BddMgr::satCount128
+
+
+//      Function : BddMgr::satCountStr
+//      Abstract : Return the satCountStr() of each of fs. Nodes the
+//      functions share are counted once.
+std::vector<std::string>
+BddMgr::satCountStr(const BddVec &fs, size_t nvars) const
+{
+  BDDVec v;
+  for (const auto &f : fs) {
+    assert(f._mgr == nullptr || f._mgr == this);
+    v.push_back(f._me);
+  } // for each function
+
+  return _impl->satCountStr(v, nvars);
+} // BddMgr::satCountStr
+
+
 //      Function : BddMgr::covers
 //      Abstract : Returns true if f covers g.
 bool
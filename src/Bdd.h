@@ -9,7 +9,9 @@
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -36,12 +38,96 @@ enum BddOp {
   IMPL
 };
 
+// Where node memory comes from. MEM_HEAP allocates it as needed.
+// MEM_MMAP reserves address space for every possible node up front
+// and lets the OS supply pages as they are first touched, so growing
+// never copies nodes. MEM_HUGE does the same and asks for transparent
+// huge pages. If the reservation fails, the heap is used.
+enum BddMemMode {
+  MEM_HEAP,
+  MEM_MMAP,
+  MEM_HUGE
+};
+
+// How nodes are laid out. LAYOUT_BANKED holds them in banks of 16K
+// nodes which are added as needed, similar to a deque. LAYOUT_FLAT
+// holds them in one array which doubles, and is copied, when full.
+// Nodes are found through the same bank table in both, so the layouts
+// differ only in how memory grows and is given back. Banked needs less
+// memory in general.
+enum BddNodeLayout {
+  LAYOUT_BANKED,
+  LAYOUT_FLAT
+};
+
+// How each level's unique table finds its nodes. UNIQ_OPEN probes a
+// flat array of (id, hash) slots, most of which are rejected by the
+// hash without touching the node. UNIQ_CHAINED keeps an array of
+// chain heads and links the nodes of a chain through a next field
+// held in a parallel array, so nodes cost 4 more bytes and each probe
+// is a dependent load into node memory, but the tables are smaller.
+// On ISCAS-85 c3540 without reordering, UNIQ_OPEN is about 5% faster
+// and needs 25% more peak memory. With reordering, UNIQ_CHAINED is
+// 2-15% faster on c2670, c3540 and c7552, with about 10% less memory.
+enum BddUniqMode {
+  UNIQ_OPEN,
+  UNIQ_CHAINED
+};
+
+// Which fields of a node are stored together. STORE_JOINED keeps the
+// reference count, marks and generation in a 16 byte record with the
+// index, hi and lo. STORE_SPLIT keeps the index, hi and lo in 12 byte
+// records and the rest in a parallel array, so the apply loop does
+// not pull the cold fields into cache, at the cost of touching two
+// arrays when marking nodes. On ISCAS-85 c2670, c3540 and c7552 the
+// two are within measurement noise of each other.
+enum BddNodeStore {
+  STORE_JOINED,
+  STORE_SPLIT
+};
+
+//      Struct   : BddConfig
+//      Abstract : Strategies chosen when a BddMgr is made. They are
+//      selected at run time so that one build can compare them on the
+//      same workload.
+//
+//      localAlloc keeps one free list per region of 256 nodes (4KB)
+//      and takes a new node from the region of its hi child when that
+//      region has room. Otherwise allocation continues through the
+//      regions in address order, so nodes made after a gc are packed
+//      together. On ISCAS-85 c7552 with reordering, building the
+//      outputs is about 35% faster, counting their nodes about 3x
+//      faster and a forced gc about 45% faster.
+//
+//      incrUniq makes a unique table resize allocate the larger array
+//      and then move a few slots of the old one on each lookup, so no
+//      single lookup pays for rehashing a large level. Lookups that
+//      miss probe both arrays until the move is done. It is ignored
+//      with UNIQ_CHAINED.
+//
+//      threads is the number of threads that share an apply, ite or
+//      andExists once it has had enough computed cache misses to be
+//      worth splitting. The calling thread is one of them. The others
+//      are started with the manager and sleep between operations, so
+//      gc and reordering always run alone.
+struct BddConfig {
+  BddMemMode memMode = MEM_HEAP;
+  BddNodeLayout layout = LAYOUT_BANKED;
+  BddUniqMode uniqMode = UNIQ_OPEN;
+  BddNodeStore nodeStore = STORE_JOINED;
+  bool localAlloc = true;
+  bool incrUniq = false;
+  size_t threads = 1;
+}; // BddConfig
+
 using BddVar = uint32_t;
 using BddLit = int32_t;
 using BddIndex = uint32_t;
 using BddVec = std::vector<Bdd>;
 using BddVarVec = std::vector<BddVar>;
 using BddIndexVec = std::vector<BddIndex>;
+using BddCount128 = unsigned __int128;
+using BddVarMap = std::map<BddVar, Bdd>;
 
 //      Class    : BddMgr
 //      Abstract : Manager for BDD memory and operations.
@@ -51,6 +137,10 @@ class BddMgr {
   BddMgr(size_t numVars);
   BddMgr(size_t numVars, size_t maxNodes);
   BddMgr(size_t numVars, size_t maxNodes, size_t cacheSz);
+  BddMgr(size_t numVars,
+         size_t maxNodes,
+         size_t cacheSz,
+         const BddConfig &config);
   ~BddMgr();
 
   BddMgr(const BddMgr &) = delete; // Copy CTOR
@@ -64,8 +154,34 @@ class BddMgr {
   Bdd getIthLit(BddIndex) const;
 
   Bdd andExists(const Bdd f, const Bdd g, const Bdd c) const;
+  Bdd applyExists(const Bdd f, const Bdd g, const Bdd c, BddOp op) const;
+  Bdd exists(const Bdd f, const Bdd c) const;
+  Bdd forall(const Bdd f, const Bdd c) const;
+  Bdd unique(const Bdd f, const Bdd c) const;
   Bdd ite(const Bdd f, const Bdd g, const Bdd h) const;
 
+  Bdd vectorCompose(const Bdd f, const BddVarMap &subst) const;
+  BddVec vectorCompose(const BddVec &fs, const BddVarMap &subst) const;
+  Bdd permute(const Bdd f, const BddVarVec &perm) const;
+  Bdd swapVariables(const Bdd f,
+                    const BddVarVec &xs,
+                    const BddVarVec &ys) const;
+
+  Bdd transfer(const Bdd &f) const;
+  BddVec transfer(const BddVec &fs) const;
+
+  Bdd conjoin(const BddVec &fs) const;
+  Bdd disjoin(const BddVec &fs) const;
+
+  double satCount(const Bdd &f, size_t nvars) const;
+  BddCount128 satCount128(const Bdd &f, size_t nvars) const;
+  std::string satCountStr(const Bdd &f, size_t nvars) const;
+  std::vector<double> satCount(const BddVec &fs, size_t nvars) const;
+  std::vector<BddCount128> satCount128(const BddVec &fs,
+                                       size_t nvars) const;
+  std::vector<std::string> satCountStr(const BddVec &fs,
+                                       size_t nvars) const;
+
   size_t countNodes(BDD f) const;
   size_t countNodes(const BddVec &bdds) const;
 
@@ -76,12 +192,20 @@ class BddMgr {
   void unlockGC() const;
   size_t gc(bool force = false, bool verbose = false) const;
   size_t reorder(bool verbose = false) const;
+  bool reset();
+  size_t compact(bool verbose = false) const;
   const BddVarVec &getVarOrder() const;
 
   bool checkMem() const;
   size_t nodesAllocd() const;
+  size_t peakNodes() const;
+  void resetPeakNodes() const;
   size_t varsCreated() const;
   void setMaxNodes(size_t maxNodes);
+  void setCacheRatio(double ratio);
+  void setAutoCompact(bool b);
+  void setBreadthFirst(size_t threshold);
+  size_t cacheSize() const;
 
   void printStats();
  private:
@@ -98,6 +222,9 @@ class BddMgr {
   Bdd abs(BDD f) const;
   Bdd apply(BDD f, BDD g, BddOp op) const;
   Bdd andExists(const BDD f, const BDD g, const BDD c) const;
+  Bdd exists(const BDD f, const BDD c) const;
+  Bdd forall(const BDD f, const BDD c) const;
+  Bdd unique(const BDD f, const BDD c) const;
   Bdd restrict(BDD f, BDD c) const;
   Bdd compose(BDD f, BddVar x, BDD g) const;
   bool covers(BDD f, BDD g) const;
@@ -166,6 +293,11 @@ class Bdd {
   Bdd implies(const Bdd &f) const;
   Bdd andExists(const Bdd &f, const Bdd &c) const;
 
+  // Quantification over the cube c.
+  Bdd exists(const Bdd &c) const;
+  Bdd forall(const Bdd &c) const;
+  Bdd unique(const Bdd &c) const;
+
   Bdd abs() const;
   Bdd restrict(const Bdd &f) const;
   Bdd compose(const BddVar x, const Bdd &g) const;
@@ -187,6 +319,9 @@ class Bdd {
   // Cubes and support.
   Bdd cubeFactor() const;
   Bdd oneCube() const;
+  double satCount(size_t nvars) const;
+  BddCount128 satCount128(size_t nvars) const;
+  std::string satCountStr(size_t nvars) const;
 
   size_t supportSize() const;
   BddVarVec supportVec() const;
@@ -387,6 +522,24 @@ inline Bdd Bdd::andExists(const Bdd &f, const Bdd &c) const {
   return _mgr->andExists(_me, f._me, c._me);
 } // Bdd::andExists
 
+inline Bdd Bdd::exists(const Bdd &c) const {
+  assert(_mgr);
+
+  return _mgr->exists(_me, c._me);
+} // Bdd::exists
+
+inline Bdd Bdd::forall(const Bdd &c) const {
+  assert(_mgr);
+
+  return _mgr->forall(_me, c._me);
+} // Bdd::forall
+
+inline Bdd Bdd::unique(const Bdd &c) const {
+  assert(_mgr);
+
+  return _mgr->unique(_me, c._me);
+} // Bdd::unique
+
 inline Bdd Bdd::abs() const {
   assert(_mgr);
 
@@ -484,6 +637,24 @@ inline Bdd Bdd::oneCube() const {
   return _mgr->oneCube(_me);
 } // Bdd::oneCube
 
+inline double Bdd::satCount(size_t nvars) const {
+  assert(_mgr);
+
+  return _mgr->satCount(*this, nvars);
+} // Bdd::satCount
+
+inline BddCount128 Bdd::satCount128(size_t nvars) const {
+  assert(_mgr);
+
+  return _mgr->satCount128(*this, nvars);
+} // Bdd::satCount128
+
+inline std::string Bdd::satCountStr(size_t nvars) const {
+  assert(_mgr);
+
+  return _mgr->satCountStr(*this, nvars);
+} // Bdd::satCountStr
+
 inline size_t Bdd::supportSize() const {
   assert(_mgr);
 
@@ -0,0 +1,309 @@
+//
+//      File     : BddImage.cc
+//      Abstract : Implementation of image computation with a
+//      partitioned transition relation.
+//
+
+#include <BddImage.h>
+#include <BddInterval.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace abide {
+
+//      Function : BddImage::BddImage
+//      Abstract : CTOR. The partitions, state variables and cluster
+//      bound are kept. The schedule for each direction is made the
+//      first time it is used.
+BddImage::BddImage(const BddMgr &mgr,
+                   const BddVec &parts,
+                   const BddVarVec &curVars,
+                   const BddVarVec &nextVars,
+                   size_t clusterSz) :
+  _mgr(&mgr),
+  _parts(parts),
+  _curVars(curVars),
+  _nextVars(nextVars),
+  _clusterSz(clusterSz)
+{
+  assert(curVars.size() == nextVars.size());
+} // BddImage::BddImage
+
+
+//      Function : BddImage::image
+//      Abstract : Return the states reachable in one step from the
+//      states in from.
+Bdd
+BddImage::image(const Bdd &from)
+{
+  Bdd to = apply(schedule(true), from);
+  return _mgr->swapVariables(to, _curVars, _nextVars);
+} // BddImage::image
+
+
+//      Function : BddImage::preimage
+//      Abstract : Return the states from which a state in to is
+//      reachable in one step.
+Bdd
+BddImage::preimage(const Bdd &to)
+{
+  Bdd next = _mgr->swapVariables(to, _curVars, _nextVars);
+  return apply(schedule(false), next);
+} // BddImage::preimage
+
+
+//      Function : BddImage::reach
+//      Abstract : Return the states reachable from init, or from which
+//      init is reachable if opts.backward is set. Each iteration takes
+//      the image of a frontier, any set that holds the states first
+//      reached by the last iteration and no state not reached yet. The
+//      frontier is the new states restricted to the states not reached
+//      before the last iteration, unless that is larger than the new
+//      states themselves. The fixpoint is reached when an iteration
+//      adds no state. If steps is given, the statistics of each
+//      iteration are appended to it. Returns an invalid Bdd if an
+//      image fails.
+Bdd
+BddImage::reach(const Bdd &init, const BddReachOpts &opts,
+                BddReachSteps *steps)
+{
+  using Clock = std::chrono::steady_clock;
+  using Secs = std::chrono::duration<double>;
+
+  Bdd reached = init;
+  Bdd frontier = init;
+  for (size_t iter = 1; reached.valid(); ++iter) {
+    auto start = Clock::now();
+    _mgr->resetPeakNodes();
+    Bdd to = opts.backward ? preimage(frontier) : image(frontier);
+    Bdd next = reached + to;
+    if (!next.valid()) {
+      return next;
+    } // if out of memory
+
+    BddReachStep step;
+    step.frontierNodes = frontier.countNodes();
+    bool done = next == reached;
+    if (!done) {
+      // States reached before the last iteration are don't cares.
+      Bdd fresh = next * ~reached;
+      frontier = fresh / ~reached;
+      if (!frontier.valid() || frontier.countNodes() > fresh.countNodes()) {
+        frontier = fresh;
+      } // if restrict did not help
+      assert(frontier <= BddInterval(fresh, next));
+    } // if not done
+    reached = next;
+
+    if (opts.gc) {
+      _mgr->gc(true);
+    } // if
+    if (opts.reorder) {
+      _mgr->reorder();
+    } // if
+
+    step.secs = Secs(Clock::now() - start).count();
+    step.peakNodes = _mgr->peakNodes();
+    step.reachedNodes = reached.countNodes();
+    if (opts.verbose) {
+      std::cout << "Reach iteration " << iter << ": "
+                << step.frontierNodes << " frontier, "
+                << step.reachedNodes << " reached, "
+                << step.peakNodes << " peak nodes ("
+                << step.secs * 1000.0 << " ms)" << std::endl;
+    } // if
+    if (steps) {
+      steps->push_back(step);
+    } // if
+    if (done || iter == opts.maxIters) {
+      break;
+    } // if
+  } // for each iteration
+
+  return reached;
+} // BddImage::reach
+
+
+//      Function : BddImage::numClusters
+//      Abstract : Return the number of clusters in the schedule of
+//      one direction.
+size_t
+BddImage::numClusters(bool forward)
+{
+  return schedule(forward)._clusters.size();
+} // BddImage::numClusters
+
+
+//      Function : BddImage::clusterNodes
+//      Abstract : Return the number of nodes in the clusters of one
+//      direction.
+size_t
+BddImage::clusterNodes(bool forward)
+{
+  return _mgr->countNodes(schedule(forward)._clusters);
+} // BddImage::clusterNodes
+
+
+//      Function : BddImage::schedule
+//      Abstract : Return the schedule of one direction, making it if
+//      need be. The image keeps the next state variables and the
+//      preimage keeps the current state variables.
+BddImage::Schedule &
+BddImage::schedule(bool forward)
+{
+  Schedule &sched = forward ? _forward : _backward;
+  if (!sched._built) {
+    buildSchedule(sched, forward ? _nextVars : _curVars);
+  } // if
+  return sched;
+} // BddImage::schedule
+
+
+//      Function : BddImage::buildSchedule
+//      Abstract : Order the partitions, conjoin runs of them in that
+//      order while the result stays within the cluster bound and find
+//      the cluster after which each variable not in keep is no longer
+//      needed.
+void
+BddImage::buildSchedule(Schedule &sched, const BddVarVec &keep)
+{
+  BddVar maxVar = 0;
+  std::vector<BddVarVec> supps;
+  for (const auto &part : _parts) {
+    supps.push_back(part.supportVec());
+    for (BddVar var : supps.back()) {
+      maxVar = std::max(maxVar, var);
+    } // for each variable
+  } // for each partition
+  for (BddVar var : keep) {
+    maxVar = std::max(maxVar, var);
+  } // for each kept variable
+  std::vector<bool> kept(maxVar + 1, false);
+  for (BddVar var : keep) {
+    kept[var] = true;
+  } // for each kept variable
+
+  Bdd cluster = _mgr->getOne();
+  for (size_t p : orderParts(supps, kept)) {
+    Bdd next = cluster * _parts[p];
+    if (!cluster.isOne() && next.countNodes() > _clusterSz) {
+      sched._clusters.push_back(cluster);
+      next = _parts[p];
+    } // if over the bound
+    cluster = next;
+  } // for each partition
+  if (!cluster.isOne()) {
+    sched._clusters.push_back(cluster);
+  } // if
+
+  // A variable is quantified with the last cluster that depends on it.
+  const size_t none = sched._clusters.size();
+  std::vector<size_t> lastUse(maxVar + 1, none);
+  for (size_t c = 0; c < sched._clusters.size(); ++c) {
+    for (BddVar var : sched._clusters[c].supportVec()) {
+      lastUse[var] = c;
+    } // for each variable
+  } // for each cluster
+  sched._cubes.assign(sched._clusters.size(), _mgr->getOne());
+  sched._unused.assign(maxVar + 1, false);
+  for (BddVar var = 1; var <= maxVar; ++var) {
+    if (kept[var]) {
+      continue;
+    } else if (lastUse[var] == none) {
+      sched._unused[var] = true;
+    } else {
+      sched._cubes[lastUse[var]] *= _mgr->getLit(var);
+    } // if
+  } // for each variable
+  sched._built = true;
+} // BddImage::buildSchedule
+
+
+//      Function : BddImage::orderParts
+//      Abstract : Return the order in which to multiply in the
+//      partitions, whose supports are supps. Each step takes the
+//      partition that retires the most variables, those not in kept on
+//      which no partition left depends, for the fewest variables it
+//      brings in that no partition taken so far depends on. Ties go to
+//      the earlier partition.
+std::vector<size_t>
+BddImage::orderParts(const std::vector<BddVarVec> &supps,
+                     const std::vector<bool> &kept)
+{
+  std::vector<size_t> users(kept.size(), 0);
+  for (const auto &supp : supps) {
+    for (BddVar var : supp) {
+      ++users[var];
+    } // for each variable
+  } // for each partition
+
+  std::vector<size_t> order;
+  std::vector<bool> taken(supps.size(), false);
+  std::vector<bool> live(kept.size(), false);
+  while (order.size() < supps.size()) {
+    size_t best = supps.size();
+    double bestScore = -1.0;
+    for (size_t p = 0; p < supps.size(); ++p) {
+      if (taken[p]) {
+        continue;
+      } // if
+      size_t retired = 0;
+      size_t added = 0;
+      for (BddVar var : supps[p]) {
+        retired += (!kept[var] && users[var] == 1);
+        added += !live[var];
+      } // for each variable
+      double score = double(retired + 1) / double(added + 1);
+      if (score > bestScore) {
+        best = p;
+        bestScore = score;
+      } // if better
+    } // for each partition left
+
+    taken[best] = true;
+    order.push_back(best);
+    for (BddVar var : supps[best]) {
+      --users[var];
+      live[var] = true;
+    } // for each variable
+  } // while
+
+  return order;
+} // BddImage::orderParts
+
+
+//      Function : BddImage::apply
+//      Abstract : Multiply the clusters of sched into from one at a
+//      time, quantifying each variable as soon as no later cluster
+//      depends on it.
+Bdd
+BddImage::apply(Schedule &sched, const Bdd &from)
+{
+  if (!from.valid()) {
+    return from;
+  } // if
+
+  Bdd unused = _mgr->getOne();
+  for (BddVar var : from.supportVec()) {
+    if (var >= sched._unused.size() || sched._unused[var]) {
+      unused *= _mgr->getLit(var);
+    } // if no cluster depends on var
+  } // for each variable
+  if (sched._clusters.empty()) {
+    return from.exists(unused);
+  } // if no relation
+
+  Bdd rtn = from;
+  for (size_t c = 0; c < sched._clusters.size(); ++c) {
+    Bdd cube = c == 0 ? sched._cubes[c] * unused : sched._cubes[c];
+    rtn = _mgr->andExists(rtn, sched._clusters[c], cube);
+    if (!rtn.valid() || rtn.isZero()) {
+      break;
+    } // if done
+  } // for each cluster
+
+  return rtn;
+} // BddImage::apply
+
+} // namespace abide
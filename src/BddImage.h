@@ -0,0 +1,109 @@
+//
+//      File     : BddImage.h
+//      Abstract : Class for image computation with a transition
+//      relation given as a conjunction of partitions. Each partition
+//      relates the current state variables, the next state variables
+//      and any other variables, such as primary inputs. The relation
+//      itself is never built. Instead, the partitions are ordered by
+//      the lifetimes of their variables, conjoined into clusters of
+//      bounded size and multiplied into the state set one cluster at a
+//      time with andExists(), which quantifies each variable as soon
+//      as no later cluster depends on it. See
+//
+//      R. K. Ranjan, A. Aziz, R. K. Brayton, B. Plessier and
+//      C. Pixley: "Efficient BDD Algorithms for FSM Synthesis and
+//      Verification," IWLS 1995.
+
+#ifndef BDDIMAGE_H
+#define BDDIMAGE_H
+
+#include <Bdd.h>
+
+namespace abide {
+
+//      Struct   : BddReachOpts
+//      Abstract : Options of BddImage::reach(). backward finds the
+//      states that can reach the initial set instead of those reachable
+//      from it. gc and reorder force a collection or a reordering after
+//      each iteration. verbose prints the statistics of each iteration.
+//      maxIters bounds the number of iterations, 0 for no bound.
+struct BddReachOpts {
+  bool backward = false;
+  bool gc = false;
+  bool reorder = false;
+  bool verbose = false;
+  size_t maxIters = 0;
+}; // BddReachOpts
+
+//      Struct   : BddReachStep
+//      Abstract : Statistics of one reachability iteration. peakNodes is
+//      the most nodes allocated at any point of the iteration, dead or
+//      alive, as given by BddMgr::peakNodes().
+struct BddReachStep {
+  double secs = 0.0;
+  size_t peakNodes = 0;
+  size_t frontierNodes = 0;
+  size_t reachedNodes = 0;
+}; // BddReachStep
+
+using BddReachSteps = std::vector<BddReachStep>;
+
+//      Class    : BddImage
+//      Abstract : Image and preimage of state sets under a partitioned
+//      transition relation. State sets are over the current state
+//      variables in both directions.
+class BddImage {
+public:
+  // Default bound on the number of nodes in a cluster.
+  static const size_t DFLT_CLUSTER_SZ = 5000;
+
+  BddImage(const BddMgr &mgr,
+           const BddVec &parts,
+           const BddVarVec &curVars,
+           const BddVarVec &nextVars,
+           size_t clusterSz = DFLT_CLUSTER_SZ);
+  ~BddImage() = default; // DTOR
+
+  BddImage(const BddImage &) = delete; // Copy CTOR
+  BddImage &operator=(const BddImage &) = delete; // Copy assignment
+  BddImage(BddImage &&) = delete; // Move CTOR
+  BddImage &operator=(BddImage &&) = delete; // Move assignment
+
+  Bdd image(const Bdd &from);
+  Bdd preimage(const Bdd &to);
+  Bdd reach(const Bdd &init,
+            const BddReachOpts &opts = BddReachOpts(),
+            BddReachSteps *steps = nullptr);
+
+  size_t numClusters(bool forward = true);
+  size_t clusterNodes(bool forward = true);
+private:
+  // The clusters in the order they are multiplied in and the cube of
+  // the variables quantified with each. _unused flags the variables
+  // to quantify on which no cluster depends. Those of the state set
+  // are quantified with the first cluster.
+  struct Schedule {
+    bool _built = false;
+    BddVec _clusters;
+    BddVec _cubes;
+    std::vector<bool> _unused;
+  }; // Schedule
+
+  Schedule &schedule(bool forward);
+  void buildSchedule(Schedule &sched, const BddVarVec &keep);
+  std::vector<size_t> orderParts(const std::vector<BddVarVec> &supps,
+                                 const std::vector<bool> &kept);
+  Bdd apply(Schedule &sched, const Bdd &from);
+
+  const BddMgr *_mgr;
+  BddVec _parts;
+  BddVarVec _curVars;
+  BddVarVec _nextVars;
+  size_t _clusterSz;
+  Schedule _forward;
+  Schedule _backward;
+}; // BddImage
+
+} // namespace abide
+
+#endif // BDDIMAGE_H
@@ -11,7 +11,8 @@ namespace abide {
 //      Abstract : CTOR
 BddImpl::BddImpl(size_t numVars,
                  size_t maxNodes,
-                 size_t cacheSz) :
+                 size_t cacheSz,
+                 const BddConfig &config) :
   _gcLock(0),
   _maxIndex(0),
   _curNodes(0),
@@ -20,22 +21,64 @@ BddImpl::BddImpl(size_t numVars,
   _maxAllocd(0),
   _nodesFree(0),
   _gcTrigger(std::min(1UL<<10, _maxNodes<<6)),
+  _numGCs(0),
   _reordering(false),
+  _autoCompact(false),
+  _flat(config.layout == LAYOUT_FLAT),
+  _splitNodes(config.nodeStore == STORE_SPLIT),
+  _nodeSz(sizeof(BddNode) + (_splitNodes ? 0 : sizeof(BddNodeAux))),
+  _nodes(nullptr),
+  _auxNodes(nullptr),
+  _chainUniq(config.uniqMode == UNIQ_CHAINED),
+  _links(nullptr),
   _freeList(0),
+  _localAlloc(config.localAlloc),
+  _allocRegion(0),
+  _incrUniq(config.incrUniq),
   _nullNode(0),
   _oneNode(0),
   _zeroNode(0),
-  _uniqTbls(*this)
+  _uniqTbls(*this),
+  _bfsThreshold(DFLT_BFS_THRESHOLD),
+  _applyLimit(SIZE_MAX),
+  _spawnDepth(0),
+  _poolGen(0),
+  _poolBusy(0),
+  _poolStop(false),
+  _parDone(false),
+  _parAbort(false),
+  _parPause(false),
+  _parked(0),
+  _compCacheSz(0),
+  _compCacheMask(0),
+  _compMisses(0),
+  _epoch(0),
+  _orderEpoch(0),
+  _compLookups(0),
+  _compEvicts(0),
+  _compMissMark(0),
+  _cacheRatio(DFLT_CACHE_RATIO),
+  _cacheReviewDue(false)
 {
   initialize(numVars, cacheSz);
+  if (config.memMode != MEM_HEAP) {
+    reserveArena(config.memMode == MEM_HUGE);
+  } // if
 
-  _nullNode = allocateNode();
-  assert(_nullNode == 0);
+  // The null node is id 0 which allocateMoreNodes() keeps off the
+  // free list.
+  allocateMoreNodes();
+  _nullNode = 0;
+  ++_nodesAllocd;
   _oneNode = allocateNode();
   _zeroNode = invert(_oneNode);
 
   BddNode &n(getNode(_oneNode));
   n.setIndex(BDD_MAX_INDEX);
+
+  if (config.threads > 1) {
+    startPool(config.threads);
+  } // if parallel
 } // BddImpl::BddImpl
 
 
@@ -43,13 +86,25 @@ BddImpl::BddImpl(size_t numVars,
 //      Abstract : DTOR
 BddImpl::~BddImpl()
 {
-#ifdef BANKEDMEM
-  for (auto *b : _banks) {
-    delete [] b;
-  } // for
-#else
-  delete [] _nodes;
-#endif
+  stopPool();
+  if (_nodeArena.valid()) {
+    return;
+  } // if the arena owns node memory
+  if (_flat) {
+    free(_nodes);
+    free(_auxNodes);
+    free(_links);
+  } else {
+    for (auto *b : _banks) {
+      free(b);
+    } // for
+    for (auto *b : _auxBanks) {
+      delete [] b;
+    } // for
+    for (auto *b : _linkBanks) {
+      delete [] b;
+    } // for
+  } // if
 } // BddImpl::~BddImpl
 
 
@@ -65,17 +120,12 @@ BddImpl::initialize(size_t numVars, size_t cacheSz)
   _maxIndex = numVars;
   _uniqTbls.resize(numVars+1);
 
+  size_t numSets = std::max<size_t>(cacheSz / CACHE_WAYS, 1);
   _compCacheSz = 1;
-  while (_compCacheSz < cacheSz) {
+  while (_compCacheSz < numSets) {
     _compCacheSz *= 2;
   } // while
   _compCacheMask = _compCacheSz - 1;
-
-  _andTbl.resize(_compCacheSz);
-  _xorTbl.resize(_compCacheSz);
-  _restrictTbl.resize(_compCacheSz);
-  _iteTbl.resize(_compCacheSz);
-  _andExistTbl.resize(_compCacheSz);
 } // BddImpl::initialize
 
 
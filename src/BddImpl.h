@@ -11,9 +11,17 @@
 #include "CacheStats.h"
 
 #include "Defines.h"
+#include "NodeArena.h"
 #include "UniqTbls.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace abide {
@@ -28,11 +36,32 @@ const size_t BDD_VEC_LG_SZ = 14;
 const size_t BDD_VEC_SZ = (1<<BDD_VEC_LG_SZ);
 const size_t BDD_VEC_MASK = (BDD_VEC_SZ-1);
 
+const size_t LOCAL_REGION_LG_SZ = 8;
+
+// Ids have a phase bit so there can be at most 2^31 nodes.
+const size_t BDD_MAX_NODES = (1UL<<31);
+
+const uint32_t BDD_GEN_SZ = (1<<6);
+const uint32_t BDD_GEN_MASK = (BDD_GEN_SZ-1);
+
 const size_t DFLT_VAR_SZ = 0;
 const size_t DFLT_NODE_SZ = UINT32_MAX;
-const size_t DFLT_CACHE_SZ = (1<<20);
+const size_t MIN_CACHE_SZ = (1<<12);
+const size_t DFLT_CACHE_SZ = MIN_CACHE_SZ;
+const double DFLT_CACHE_RATIO = 1.0;
 
 const double DFLT_REORDER_GROWTH_FACTOR = 1.25;
+
+// Computed cache misses after which apply() switches to breadth first.
+const size_t DFLT_BFS_THRESHOLD = (1<<16);
+
+// Computed cache misses after which an operation is handed to the
+// worker threads, the number of levels below the top at which they
+// spawn tasks beyond those needed to give each thread one, and the
+// number of nodes a worker takes from the free list at a time.
+const size_t PAR_THRESHOLD = (1<<12);
+const size_t PAR_SPAWN_EXTRA = 4;
+const size_t PAR_ALLOC_BATCH = 256;
 } // anonymous namespace
 
 
@@ -43,7 +72,8 @@ class BddImpl {
   // BddImpl.cc
   BddImpl(size_t numVars,
           size_t maxNodes,
-          size_t cacheSz);
+          size_t cacheSz,
+          const BddConfig &config);
   ~BddImpl();
   void initialize(size_t numVars, size_t cacheSz);
 
@@ -58,11 +88,21 @@ class BddImpl {
   BDD apply(BDD f, BDD g, BddOp op);
   BDD restrict(BDD f, BDD c);
   BDD compose(BDD f, BddVar x, BDD g);
+  BDDVec vectorCompose(const BDDVec &fs,
+                       const std::map<BddVar, BDD> &subst);
+  BDDVec transfer(const BddImpl &src, const BDDVec &fs);
   BDD andExists(BDD f, BDD g, BDD c);
+  BDD applyExists(BDD f, BDD g, BDD c, BddOp op);
+  BDD exists(BDD f, BDD c);
+  BDD forall(BDD f, BDD c);
+  BDD unique(BDD f, BDD c);
   bool covers(BDD f, BDD g);
   BDD cubeFactor(BDD f);
   BDD oneCube(BDD f);
   BDD ite(BDD f, BDD g, BDD h);
+  std::vector<double> satCount(const BDDVec &fs, size_t nvars);
+  std::vector<BddCount128> satCount128(const BDDVec &fs, size_t nvars);
+  std::vector<std::string> satCountStr(const BDDVec &fs, size_t nvars);
 
   size_t supportSize(BDD f);
   BDD supportCube(BDD f);
@@ -71,11 +111,15 @@ class BddImpl {
   // BddImplMem.cc
   size_t gc(bool force, bool verbose);
   size_t reorder(bool verbose);
+  bool reset();
+  size_t compact(bool verbose);
 
   const BddVarVec &getVarOrder() const { return _index2BddVar; };
 
   bool checkMem() const;
   size_t nodesAllocd() const { return _nodesAllocd; };
+  size_t maxAllocd() const { return _maxAllocd; };
+  void resetMaxAllocd() { _maxAllocd = _nodesAllocd; };
   size_t varsCreated() const { return _maxIndex; };
 
   void incRef(BDD F) const;
@@ -110,9 +154,14 @@ class BddImpl {
   BDD abs(BDD f) const { return f & ~0x01; };
 
   void setMaxNodes(size_t maxNodes) {_maxNodes = std::max(_nodesAllocd,maxNodes);};
+  void setCacheRatio(double ratio) { _cacheRatio = ratio; };
+  void setAutoCompact(bool b) { _autoCompact = b; };
+  void setBreadthFirst(size_t threshold) { _bfsThreshold = threshold; };
+  size_t cacheSize() const { return _compCacheSz * CACHE_WAYS; };
   void printStats() { _cacheStats.print(); };
  private:
   friend class UniqTbl;
+  friend class UniqTbls;
   BDD apply2(BDD f, BDD g, BddOp op);
 
   enum Unateness {
@@ -150,24 +199,22 @@ class BddImpl {
     BddNode &n = getNode(f, mask);
     return n.getLo() ^ mask;
   };
-  BDD getNext(BDD f) const {
-    BddNode &n = getNode(f);
-    return n.getNext();
-  };
+  BDD getNext(BDD f) const { return getLink(f); };
+  void setNext(BDD f, BDD n) const { getLink(f) = n; };
   void markNode(BDD f, uint32_t m) const {
-    BddNode &n = getNode(f);
+    BddNodeAux &n = getAux(f);
     n.setMark(m);
   };
   void unmarkNode(BDD f, uint32_t m) const {
-    BddNode &n = getNode(f);
+    BddNodeAux &n = getAux(f);
     n.clrMark(m);
   };
   bool nodeMarked(BDD f, uint32_t m) const {
-    BddNode &n = getNode(f);
+    BddNodeAux &n = getAux(f);
     return n.marked(m);
   };
   bool nodeUnmarked(BDD f, uint32_t m) const {
-    BddNode &n = getNode(f);
+    BddNodeAux &n = getAux(f);
     return ! n.marked(m);
   };
 
@@ -178,15 +225,26 @@ class BddImpl {
     return getNode(i);
   }; // getNode
   BddNode *getNodePtr(BDD i) const;
+  BddNodeAux &getAux(BDD i) const;
+  BDD &getLink(BDD i) const;
 
   // Allocating and freeing nodes.
-  BDD allocateNode();
+  void reserveArena(bool huge);
+  BDD allocateNode(BDD near = 0);
+  void clearNode(BDD f);
   void allocateMoreNodes();
+  void setFlatBanks(size_t numNodes);
   void freeNode(BDD f);
+  void rebuildFreeList();
+  void pushFree(BDD f);
+  BDD popFree(BDD near);
   BDD findOrAddUniqTbl(BddIndex index,
                        BDD hi,
                        BDD lo);
+  void prefetchUniqTbl(BddIndex index, BDD hi, BDD lo);
 
+  template <typename Fn> void forEachNode(const UniqTbl &tbl, Fn fn) const;
+  template <typename Fn> void walkNodes(BDD f, Fn fn) const;
   void markReferencedNodes();
   // Avoid using m=0 unless gc is locked.
   void markNodes(BDD f, uint32_t m) const;
@@ -218,20 +276,133 @@ class BddImpl {
 
   BDD and2(BDD f, BDD g);
 
+  // Explicit-stack apply for and, xor, ite and the quantifiers. A
+  // frame is one operation, f, g and h in standard form, waiting on
+  // its cofactors. _first holds the result of the first of them,
+  // _flag is the output inversion of ite or whether a quantifier
+  // quantifies _index. See applyIter().
+  struct ApplyFrame {
+    BDD _f;
+    BDD _g;
+    BDD _h;
+    BDD _first;
+    size_t _misses;
+    BddIndex _index;
+    uint8_t _step;
+    bool _flag;
+  }; // ApplyFrame
+  using ApplyStack = std::vector<ApplyFrame>;
+
+  // The quantifiers take a cube of variables in h. exists() and
+  // unique() have g one. The cofactors of a quantified variable are
+  // combined by or, or by xor for unique(), and the lo one is
+  // computed first.
+  static constexpr bool quantOp(CacheOp op) {
+    return (op == CACHE_ANDEXISTS || op == CACHE_XOREXISTS
+            || op == CACHE_EXISTS || op == CACHE_UNIQUE);
+  }; // quantOp
+
+  // Parallel apply. A task is an operation spawned for another worker
+  // to steal. A worker is the state of one thread taking part in a
+  // parallel operation: its apply stack, the nodes it has taken from
+  // the free list and its share of the computed cache counts. The
+  // tasks it spawns are on _tasks. It takes them back from the end
+  // and idle workers steal them from the front. Worker 0 belongs to
+  // the thread that called the manager. See BddImplPar.cc.
+  struct BddTask {
+    CacheOp _op;
+    BDD _f;
+    BDD _g;
+    BDD _h;
+    size_t _depth;
+    BDD _rtn;
+    std::atomic<bool> _done;
+  }; // BddTask
+  struct BddWorker {
+    size_t _id = 0;
+    ApplyStack _stack;
+    BDDVec _free;
+    size_t _lookups = 0;
+    size_t _misses = 0;
+    size_t _missMark = 0;
+    size_t _evicts = 0;
+    std::mutex _lock;
+    std::deque<BddTask *> _tasks;
+  }; // BddWorker
+
+  template <CacheOp OP> BDD applyTop(BDD f, BDD g, BDD h);
+  template <CacheOp OP> BDD quantify(BDD f, BDD c);
+  template <CacheOp OP, bool PAR = false>
+  BDD applyIter(BDD f, BDD g, BDD h, BddWorker *w = nullptr);
+  template <CacheOp OP, bool PREFETCH = true, bool PAR = false>
+  bool applyStart(ApplyFrame &frame, BDD &rtn, BddWorker *w = nullptr);
+  template <CacheOp OP, bool PAR = false>
+  BDD applyFinish(const ApplyFrame &frame, BDD second, BddWorker *w = nullptr);
+  template <CacheOp OP> void applyPrefetch(const ApplyFrame &frame);
+
+  // Breadth-first apply for and and xor. A request is one operation
+  // waiting on its cofactors. A cofactor settled by a terminal case or
+  // the computed cache is held in _hi or _lo. Otherwise _hiReq or
+  // _loReq is the request computing it. Requests are queued by the
+  // level of their top variable. See applyBfs().
+  static constexpr uint32_t BFS_NO_REQ = UINT32_MAX;
+  struct BfsRequest {
+    BDD _f;
+    BDD _g;
+    BDD _hi;
+    BDD _lo;
+    uint32_t _hiReq;
+    uint32_t _loReq;
+    uint32_t _cost;
+    BDD _rtn;
+  }; // BfsRequest
+  using BfsReqIds = std::vector<uint32_t>;
+  struct BfsQueues {
+    std::vector<BfsRequest> _reqs;
+    std::vector<BfsReqIds> _levels;
+    BfsReqIds _hash;
+  }; // BfsQueues
+  template <CacheOp OP> BDD applyBfs(BDD f, BDD g);
+  template <CacheOp OP> void bfsExpand(BfsQueues &queues, BddIndex level);
+  template <CacheOp OP> bool bfsReduce(BfsQueues &queues, BddIndex level);
+  uint32_t bfsRequest(BfsQueues &queues, const ApplyFrame &frame);
+
+  // BddImplPar.cc
+  void startPool(size_t numThreads);
+  void stopPool();
+  void workerLoop(size_t id);
+  template <CacheOp OP> BDD applyParallel(BDD f, BDD g, BDD h);
+  template <CacheOp OP>
+  BDD applyTask(BddWorker &w, BDD f, BDD g, BDD h, size_t depth);
+  void runTask(BddWorker &w, BddTask &task);
+  bool stealTask(BddWorker &w);
+  bool prepareParallel();
+  void beginParallel();
+  void endParallel();
+  void pauseParallel();
+  bool growParallel();
+  void mergeParallelCounts();
+  BDD allocateShared(BDDVec &spare);
+  BDD makeNodeShared(BddWorker &w, BddIndex index, BDD hi, BDD lo);
+  BDD getCacheShared(BddWorker &w, CacheOp op, BDD f, BDD g, BDD h);
+  void insertCacheShared(BddWorker &w,
+                         CacheOp op,
+                         BDD f,
+                         BDD g,
+                         BDD h,
+                         BDD r,
+                         size_t cost);
+
   BDD xor2(BDD f, BDD g);
   BDD andConstant(BDD f, BDD g);
   bool andConstantTerminal(BDD f, BDD g, BDD &rtn);
   BDD andExists2(BDD f, BDD g, BDD c);
-  BDD andExistsTerminal(BDD f, BDD g, BDD c);
+  BDD applyExists2(BDD f, BDD g, BDD c, BddOp op);
   void orderOps(BDD &f, BDD &g) {
     if (f > g) { std::swap(f, g); }
   }; // orderOps
 
-  BDD nand2(BDD f, BDD g) { return invert(and2(f, g)); };
   BDD or2(BDD f, BDD g) { return invert(and2(invert(f), invert(g))); };
-  BDD nor2(BDD f, BDD g) { return and2(invert(f), invert(g)); } ;
-  BDD xnor2(BDD f, BDD g) { return invert(xor2(f, g)); };
-  BDD impl2(BDD f, BDD g) { return invert(and2(f, invert(g))); };
 
   //ite
   bool stdTrip(BDD &f, BDD &g, BDD &h);
@@ -243,63 +414,80 @@ class BddImpl {
 
   BDD makeNode(BddIndex index, BDD hi, BDD lo);
 
-  BDD restrictRec(BDD f, BDD c);
+  BDD restrictIter(BDD f, BDD c);
+  bool restrictStart(ApplyFrame &frame, BDD &rtn);
   bool restrictTerminal(BDD f, BDD c, BDD &rtn);
   BDD reduce(BDD f, BddIndex tgt);
 
   using BitVec = std::vector<bool>;
   void fillSupportVec(BDD f, BitVec &suppVec);
-  size_t countNodes(BDD f) const;
 
-  // Computed caches.
-  struct CacheData2 {
-    BDD _f;
-    BDD _g;
-    BDD _r;
-  }; // CacheData2
-  using ComputedTbl2 = std::vector<CacheData2>;
+  template <class Count>
+  std::vector<Count> countMinterms(const BDDVec &fs, size_t nvars);
+  size_t countNodes(BDD f) const;
 
-  struct CacheData3 {
+  // Computed cache. One table holds the results of every cached
+  // operation. Entries are tagged with the operation and grouped in
+  // sets of CACHE_WAYS which share a cache line with a lock used only
+  // by parallel operations. The cost of an entry
+  // is the number of cache misses incurred while computing it and is
+  // used to pick a victim when a set is full. Entries are validated
+  // when they are found rather than swept after each gc. See
+  // cacheEntryValid().
+  static constexpr size_t CACHE_WAYS = 2;
+  static constexpr uint32_t CACHE_MAX_COST = (1<<24) - 1;
+  struct CacheEntry {
     BDD _f;
     BDD _g;
     BDD _h;
     BDD _r;
-  }; // CacheData3
-  using ComputedTbl3 = std::vector<CacheData3>;
-
-
-  BDD getAndCache(BDD f, BDD g);
-  void insertAndCache(BDD f, BDD g, BDD r);
-  BDD getXorCache(BDD f, BDD g);
-  void insertXorCache(BDD f, BDD g, BDD r);
-  BDD getRestrictCache(BDD f, BDD g);
-  void insertRestrictCache(BDD f, BDD g, BDD r);
-  BDD getIteCache(BDD f, BDD g, BDD h);
-  void insertIteCache(BDD f,
-                      BDD g,
-                      BDD h,
-                      BDD r);
-  BDD getAndExistsCache(BDD f, BDD g, BDD h);
-  void insertAndExistsCache(BDD f,
-                            BDD g,
-                            BDD c,
-                            BDD r);
-
-  void cleanCaches(bool force);
-  void cleanCache(ComputedTbl2 &table, bool force);
-  void cleanCache(ComputedTbl3 &table, bool force);
-
-  void cleanAndCache(bool force);
-  void cleanXorCache(bool force);
-  void cleanRestrictCache(bool force);
-  void cleanIteCache(bool force);
-  void cleanAndExistsCache(bool force);
+    uint32_t _op:8;
+    uint32_t _cost:24;
+    uint32_t _epoch;
+  }; // CacheEntry
+  struct alignas(64) CacheSet {
+    CacheEntry _way[CACHE_WAYS];
+    uint32_t _lock;
+  }; // CacheSet
+  using ComputedTbl = std::vector<CacheSet>;
+
+  BDD getCache(CacheOp op, BDD f, BDD g, BDD h);
+  BDD findCacheEntry(CacheSet &set, CacheOp op, BDD f, BDD g, BDD h);
+  CacheOp putCacheEntry(CacheSet &set,
+                        CacheOp op,
+                        BDD f,
+                        BDD g,
+                        BDD h,
+                        BDD r,
+                        size_t cost);
+  void insertCache(CacheOp op,
+                   BDD f,
+                   BDD g,
+                   BDD h,
+                   BDD r,
+                   size_t cost);
+  CacheSet &getCacheSet(CacheOp op, BDD f, BDD g, BDD h);
+  size_t cacheSetIndex(CacheOp op, BDD f, BDD g, BDD h) const {
+    uint64_t hash = ((f * 0x9e3779b97f4a7c15ULL) ^
+                     (g * 0xc2b2ae3d27d4eb4fULL) ^
+                     (h * 0x165667b19e3779f9ULL) ^
+                     op);
+    return (hash ^ (hash >> 32)) & _compCacheMask;
+  }; // cacheSetIndex
+  bool cacheEntryValid(const CacheEntry &entry) const;
+  void tuneCache(size_t nodesFreed);
+  void growCache();
+  bool cacheShouldGrow() const;
+  void resizeCache(size_t numEntries);
 
   BddIndex index(BDD f) const;
   BddIndex minIndex(BDD f, BDD g) const;
   BddIndex minIndex(BDD f, BDD g, BDD h) const;
   BDD restrict1(BDD f, BddIndex index) const;
   BDD restrict0(BDD f, BddIndex index) const;
+  BDD cofactor(BDD f, BddIndex index, bool hiSide) const {
+    return hiSide ? restrict1(f, index) : restrict0(f, index);
+  }; // cofactor
 
   void printRec(BDD f, size_t level) const;
 
@@ -320,20 +508,57 @@ class BddImpl {
   size_t _maxAllocd;
   size_t _nodesFree;
   size_t _gcTrigger;
+  size_t _numGCs;
 
   bool _reordering;
-
-  // Managed node memory.
-#ifdef BANKEDMEM
-  using BddBank = BddNode *;
+  bool _autoCompact;
+
+  // Managed node memory. With LAYOUT_BANKED, nodes are held in banks
+  // of BDD_VEC_SZ, similar to a deque. With LAYOUT_FLAT, they are held
+  // in one array, _nodes, that is doubled as needed, and _banks points
+  // into it. Nodes are always found through _banks so that the layout
+  // costs nothing on the lookup path. See setFlatBanks(). Node
+  // records are _nodeSz bytes: a BddNode, followed by its BddNodeAux
+  // unless _splitNodes is set. Then the aux fields are held in banks,
+  // or a flat array, parallel to the nodes.
+  bool _flat;
+  bool _splitNodes;
+  size_t _nodeSz;
+  using BddBank = char *;
   using BddBanks = std::vector<BddBank>;
   BddBanks _banks;
-#else
-  BddNode *_nodes;
-#endif
-
-  // List of free nodes.
+  char *_nodes;
+  using BddAuxBank = BddNodeAux *;
+  using BddAuxBanks = std::vector<BddAuxBank>;
+  BddAuxBanks _auxBanks;
+  BddNodeAux *_auxNodes;
+
+  // Unique table chains, with UNIQ_CHAINED. The next field of each
+  // node is held in banks, or a flat array, parallel to the nodes.
+  bool _chainUniq;
+  using BddLinkBank = BDD *;
+  using BddLinkBanks = std::vector<BddLinkBank>;
+  BddLinkBanks _linkBanks;
+  BDD *_links;
+
+  // Address space for node memory when not using the heap. The banks
+  // or the flat array are placed in it rather than allocated. The
+  // node arena is in bytes as the record size is chosen at run time.
+  NodeArena<char> _nodeArena;
+  NodeArena<BddNodeAux> _auxArena;
+  NodeArena<BDD> _linkArena;
+
+  // List of free nodes. The list is threaded through the hi field.
   BDD _freeList;
+  // With _localAlloc there is a list for each region of
+  // 2^LOCAL_REGION_LG_SZ nodes instead. _allocRegion is where
+  // allocation continues when the preferred region is full.
+  bool _localAlloc;
+  BDDVec _regionFree;
+  size_t _allocRegion;
+
+  // Unique tables are resized a few slots at a time. See UniqTbl.
+  bool _incrUniq;
 
   // Constant nodes.
   BDD _nullNode;
@@ -343,16 +568,68 @@ class BddImpl {
   // Unique tables.
   UniqTbls _uniqTbls;
 
-  // Computed tables.
+  // Work stacks of applyIter() and walkNodes(). They are kept so that
+  // their memory is reused from one call to the next.
+  ApplyStack _applyStack;
+  mutable BDDVec _visitStack;
+
+  // apply() switches to breadth first once an operation has had
+  // _bfsThreshold computed cache misses. 0 disables it. _applyLimit is
+  // the miss count at which applyStart() gives up, if any.
+  size_t _bfsThreshold;
+  size_t _applyLimit;
+
+  // Worker threads, if the manager has any. They wait on _poolWake
+  // between parallel operations, so gc() and reorder(), which are
+  // only called between operations, always run with the workers
+  // stopped. _poolGen counts parallel operations, _poolBusy the
+  // workers still taking part in the current one and _parDone is set
+  // when it is finished. A worker that finds a unique table full
+  // sets _parPause and waits for the other _parked workers, then
+  // grows the tables while they are held under _pauseLock. _parAbort
+  // is set when nothing could grow. _allocLock guards the free lists
+  // while the workers run.
+  std::vector<std::unique_ptr<BddWorker>> _workers;
+  std::vector<std::thread> _threads;
+  size_t _spawnDepth;
+  std::mutex _poolLock;
+  std::condition_variable _poolWake;
+  std::condition_variable _poolIdle;
+  size_t _poolGen;
+  size_t _poolBusy;
+  bool _poolStop;
+  std::atomic<bool> _parDone;
+  std::atomic<bool> _parAbort;
+  std::atomic<bool> _parPause;
+  std::mutex _pauseLock;
+  std::condition_variable _pauseWake;
+  size_t _parked;
+  std::mutex _allocLock;
+
+  // Computed table. It is not allocated until the first lookup so
+  // _compCacheSz is the number of sets it has or will have.
   size_t _compCacheSz;
   size_t _compCacheMask;
-
-  ComputedTbl2 _andTbl;
-  ComputedTbl2 _xorTbl;
-  ComputedTbl2 _restrictTbl;
-
-  ComputedTbl3 _iteTbl;
-  ComputedTbl3 _andExistTbl;
+  ComputedTbl _compTbl;
+
+  // Total computed table misses. Used to find the cost of a result.
+  size_t _compMisses;
+
+  // Number of garbage collections and reorders. Nodes and cache
+  // entries are stamped with it. _orderEpoch is the epoch of the
+  // last reorder.
+  uint32_t _epoch;
+  uint32_t _orderEpoch;
+
+  // Computed table activity since the size was last reviewed and the
+  // limit on its size as a multiple of node memory. _cacheReviewDue
+  // is set once there have been as many lookups as entries, and the
+  // review is done when the operation ends. See gc().
+  size_t _compLookups;
+  size_t _compEvicts;
+  size_t _compMissMark;
+  double _cacheRatio;
+  bool _cacheReviewDue;
 
   // Stats
   CacheStats _cacheStats;
@@ -364,35 +641,104 @@ class BddImpl {
 inline BddNode &
 BddImpl::getNode(BDD i) const
 {
-#ifdef BANKEDMEM
-  i = i>>1;
-  size_t bdx = i >> BDD_VEC_LG_SZ;
-  i &= BDD_VEC_MASK;
-  BddBank bank = _banks[bdx];
-  return bank[i];
-#else
-  i = i>>1;
-  return _nodes[i];
-#endif
+  return *getNodePtr(i);
 } // BddImpl::getNode
 
 
-//      Function : BddImpl::getNode
+//      Function : BddImpl::getNodePtr
 //      Abstract : Decode the BDD address and return a pointer.
 inline BddNode *
 BddImpl::getNodePtr(BDD i) const
 {
-#ifdef BANKEDMEM
   i = i>>1;
   size_t bdx = i >> BDD_VEC_LG_SZ;
   i &= BDD_VEC_MASK;
   BddBank bank = _banks[bdx];
-  return bank+i;
-#else
+  return reinterpret_cast<BddNode *>(bank + i * _nodeSz);
+} // BddImpl::getNodePtr
+
+
+//      Function : BddImpl::getAux
+//      Abstract : Decode the BDD address and return a reference to
+//      the auxiliary fields of the node, which follow it in its
+//      record unless _splitNodes is set.
+inline BddNodeAux &
+BddImpl::getAux(BDD i) const
+{
+  if (!_splitNodes) {
+    return *reinterpret_cast<BddNodeAux *>(getNodePtr(i) + 1);
+  } // if joined
   i = i>>1;
-  return _nodes+i;
-#endif
-} // BddImpl::getNode
+  size_t bdx = i >> BDD_VEC_LG_SZ;
+  i &= BDD_VEC_MASK;
+  BddAuxBank bank = _auxBanks[bdx];
+  return bank[i];
+} // BddImpl::getAux
+
+
+//      Function : BddImpl::getLink
+//      Abstract : Decode the BDD address and return a reference to
+//      the unique table chain field of the node. Only valid with
+//      UNIQ_CHAINED.
+inline BDD &
+BddImpl::getLink(BDD i) const
+{
+  i = i>>1;
+  size_t bdx = i >> BDD_VEC_LG_SZ;
+  i &= BDD_VEC_MASK;
+  BddLinkBank bank = _linkBanks[bdx];
+  return bank[i];
+} // BddImpl::getLink
+
+
+//      Function : BddImpl::forEachNode
+//      Abstract : Call fn on every node in the unique table. fn must
+//      not add nodes to or remove nodes from the table.
+template <typename Fn>
+inline void
+BddImpl::forEachNode(const UniqTbl &tbl, Fn fn) const
+{
+  for (size_t hdx = 0; hdx < tbl.size(); ++hdx) {
+    BDD f = tbl.getHash(hdx);
+    if (!_chainUniq) {
+      if (f) {
+        fn(f);
+      } // if slot used
+      continue;
+    } // if open addressed
+    while (f) {
+      BDD next = getNext(f);
+      fn(f);
+      f = next;
+    } // while nodes to process
+  } // for each hash
+} // BddImpl::forEachNode
+
+
+//      Function : BddImpl::walkNodes
+//      Abstract : Visit the nodes reachable from f without recursion.
+//      fn(g) is called on each node reached and returns true if the
+//      children of g are to be visited. The walk follows lo children
+//      in a loop and saves the hi children on _visitStack, so a call
+//      that stops at f does not touch the stack.
+template <typename Fn>
+inline void
+BddImpl::walkNodes(BDD f, Fn fn) const
+{
+  const size_t base = _visitStack.size();
+  while (true) {
+    while (fn(f)) {
+      BddNode &node = getNode(f);
+      _visitStack.push_back(node.getHi());
+      f = node.getLo();
+    } // while descending
+    if (_visitStack.size() == base) {
+      return;
+    } // if done
+    f = _visitStack.back();
+    _visitStack.pop_back();
+  } // while nodes to visit
+} // BddImpl::walkNodes
 
 
 //      Function : BddImpl::makeNode
@@ -411,6 +757,72 @@ BddImpl::makeNode(BddIndex index, BDD hi, BDD lo)
 } // BddImpl::makeNode
 
 
+//      Function : BddImpl::findCacheEntry
+//      Abstract : Returns the result of op(f,g,h) if set holds a valid
+//      entry for it. An entry found to be invalid is cleared.
+inline BDD
+BddImpl::findCacheEntry(CacheSet &set, CacheOp op, BDD f, BDD g, BDD h)
+{
+  for (auto &entry : set._way) {
+    if (entry._f == f && entry._g == g && entry._h == h && entry._op == op) {
+      if (cacheEntryValid(entry)) {
+        return entry._r;
+      } // if
+      entry._op = CACHE_NONE;
+      break;
+    } // if
+  } // for each way
+
+  return _nullNode;
+} // BddImpl::findCacheEntry
+
+
+//      Function : BddImpl::putCacheEntry
+//      Abstract : Puts r into set as the result of op(f,g,h). If the
+//      set is full, the entry with the lowest cost is replaced and the
+//      costs of the others are halved so that old entries eventually
+//      give way. Returns the op of the entry replaced, if any.
+inline CacheOp
+BddImpl::putCacheEntry(CacheSet &set,
+                       CacheOp op,
+                       BDD f,
+                       BDD g,
+                       BDD h,
+                       BDD r,
+                       size_t cost)
+{
+  CacheEntry *victim = &set._way[0];
+  bool evict = true;
+  for (auto &entry : set._way) {
+    if (entry._op == CACHE_NONE) {
+      victim = &entry;
+      evict = false;
+      break;
+    } else if (entry._cost < victim->_cost) {
+      victim = &entry;
+    } // if
+  } // for each way
+
+  CacheOp evicted = CACHE_NONE;
+  if (evict) {
+    evicted = static_cast<CacheOp>(victim->_op);
+    for (auto &entry : set._way) {
+      entry._cost >>= 1;
+    } // for each way
+  } // if
+
+  victim->_f = f;
+  victim->_g = g;
+  victim->_h = h;
+  victim->_r = r;
+  victim->_op = op;
+  victim->_cost = std::min<size_t>(cost, CACHE_MAX_COST);
+  victim->_epoch = _epoch;
+
+  return evicted;
+} // BddImpl::putCacheEntry
+
+
 //      Function : BddImpl::minIndex
 //      Abstract : Return the minimum index of f, g and h.
 inline BddIndex
@@ -451,6 +863,17 @@ BddImpl::restrict0(BDD f, BddIndex idx) const
 } // restrict0
 
 
+//      Function : prefetch
+//      Abstract : Hint that p will be read soon.
+inline void
+prefetch([[maybe_unused]] const void *p)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(p);
+#endif
+} // prefetch
+
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Simple hash functions.
 //
@@ -6,9 +6,114 @@
 #include <BddImpl.h>
 #include <cassert>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
 
 namespace abide {
 
+namespace {
+// Hash of the operands of a breadth-first request.
+inline size_t bfsHash(const BDD f, const BDD g) {
+  uint64_t key = (static_cast<uint64_t>(f) << 32) | g;
+  return (key * 0x9E3779B97F4A7C15ULL) >> 32;
+} // bfsHash
+
+// Counts of satisfying assignments. countShift() multiplies by 2^k,
+// where k is never negative, and countAdd() adds. The 128-bit counts
+// saturate at the largest value.
+inline void countShift(double &c, int k) {
+  c = std::ldexp(c, k);
+} // countShift
+
+inline void countAdd(double &c, const double &d) {
+  c += d;
+} // countAdd
+
+inline void countShift(BddCount128 &c, int k) {
+  const BddCount128 max = ~BddCount128(0);
+  if (c != 0) {
+    c = k < 128 && c <= (max >> k) ? c << k : max;
+  } // if
+} // countShift
+
+inline void countAdd(BddCount128 &c, const BddCount128 &d) {
+  const BddCount128 max = ~BddCount128(0);
+  c = c <= max - d ? c + d : max;
+} // countAdd
+
+// Arbitrary precision count in base 2^32, least significant limb
+// first, with no high zero limbs.
+struct BigCount {
+  BigCount(uint32_t val = 0) {
+    if (val != 0) {
+      _limbs.push_back(val);
+    } // if
+  } // BigCount
+  std::vector<uint32_t> _limbs;
+}; // BigCount
+
+inline void countShift(BigCount &c, int k) {
+  auto &limbs = c._limbs;
+  if (limbs.empty() || k == 0) {
+    return;
+  } // if
+  size_t words = k / 32;
+  int bits = k % 32;
+  limbs.insert(limbs.begin(), words, 0);
+  if (bits != 0) {
+    uint32_t carry = 0;
+    for (size_t i = words; i < limbs.size(); ++i) {
+      uint32_t limb = limbs[i];
+      limbs[i] = (limb << bits) | carry;
+      carry = limb >> (32 - bits);
+    } // for each limb
+    if (carry != 0) {
+      limbs.push_back(carry);
+    } // if
+  } // if
+} // countShift
+
+inline void countAdd(BigCount &c, const BigCount &d) {
+  auto &limbs = c._limbs;
+  limbs.resize(std::max(limbs.size(), d._limbs.size()), 0);
+  uint64_t carry = 0;
+  for (size_t i = 0; i < limbs.size(); ++i) {
+    carry += uint64_t(limbs[i]) + (i < d._limbs.size() ? d._limbs[i] : 0);
+    limbs[i] = uint32_t(carry);
+    carry >>= 32;
+  } // for each limb
+  if (carry != 0) {
+    limbs.push_back(uint32_t(carry));
+  } // if
+} // countAdd
+
+// Return c in decimal.
+std::string countStr(BigCount c) {
+  auto &limbs = c._limbs;
+  std::string digits;
+  while (!limbs.empty()) {
+    // Divide by 10^9 and prepend the remainder.
+    uint64_t rem = 0;
+    for (size_t i = limbs.size(); i-- > 0; ) {
+      uint64_t cur = (rem << 32) | limbs[i];
+      limbs[i] = uint32_t(cur / 1000000000);
+      rem = cur % 1000000000;
+    } // for each limb
+    while (!limbs.empty() && limbs.back() == 0) {
+      limbs.pop_back();
+    } // while
+    std::string chunk = std::to_string(rem);
+    if (!limbs.empty()) {
+      chunk.insert(0, 9 - chunk.size(), '0');
+    } // if
+    digits.insert(0, chunk);
+  } // while
+
+  return digits.empty() ? "0" : digits;
+} // countStr
+} // anonymous namespace
+
 //      Function : BddImpl::apply
 //      Abstract : Apply OP to F and G with retry after gc if null..
 BDD
@@ -35,25 +140,25 @@ BddImpl::apply2(BDD f, BDD g, BddOp op)
   BDD r = _nullNode;
   switch (op) {
    case AND:
-    r = and2(f, g);
+    r = applyTop<CACHE_AND>(f, g, _nullNode);
     break;
    case NAND:
-    r = nand2(f, g);
+    r = invert(applyTop<CACHE_AND>(f, g, _nullNode));
     break;
    case OR:
-    r = or2(f, g);
+    r = invert(applyTop<CACHE_AND>(invert(f), invert(g), _nullNode));
     break;
    case NOR:
-    r = nor2(f, g);
+    r = applyTop<CACHE_AND>(invert(f), invert(g), _nullNode);
     break;
    case XOR:
-    r = xor2(f, g);
+    r = applyTop<CACHE_XOR>(f, g, _nullNode);
     break;
    case XNOR:
-    r = xnor2(f, g);
+    r = invert(applyTop<CACHE_XOR>(f, g, _nullNode));
     break;
    case IMPL:
-    r = impl2(f, g);
+    r = invert(applyTop<CACHE_AND>(f, invert(g), _nullNode));
     break;
    default:
     assert(false);
@@ -62,15 +167,202 @@ BddImpl::apply2(BDD f, BDD g, BddOp op)
   return r;
 } // BddImpl::apply2
 
+
+//      Function : BddImpl::applyTop
+//      Abstract : Computes OP(f,g,h) for a caller outside the apply
+//      engine. It starts depth first with a budget of computed cache
+//      misses. An operation that goes over the budget is finished by
+//      the worker threads if there are any, or else breadth first for
+//      and and xor. The results found by then are in the computed
+//      cache for the second pass.
+template <CacheOp OP>
+BDD
+BddImpl::applyTop(BDD f, BDD g, BDD h)
+{
+  constexpr bool bfsOp = (OP == CACHE_AND || OP == CACHE_XOR);
+  const size_t budget = (!_workers.empty() ? PAR_THRESHOLD
+                         : bfsOp ? _bfsThreshold
+                         : 0);
+  if (budget == 0) {
+    return applyIter<OP>(f, g, h);
+  } // if no budget
+
+  _applyLimit = _compMisses + budget;
+  BDD rtn = applyIter<OP>(f, g, h);
+  const bool large = isNull(rtn) && _compMisses > _applyLimit;
+  _applyLimit = SIZE_MAX;
+  if (large) {
+    if (!_workers.empty()) {
+      rtn = applyParallel<OP>(f, g, h);
+    } else if constexpr (bfsOp) {
+      rtn = applyBfs<OP>(f, g);
+    } // if
+  } // if over budget
+
+  return rtn;
+} // BddImpl::applyTop
+
+
+//      Function : BddImpl::applyBfs
+//      Abstract : Computes OP(f,g) a level at a time. Expansion visits
+//      the levels top down, splitting each queued request into its
+//      cofactors. A cofactor that is not settled by a terminal case or
+//      the computed cache becomes a request on the level of its top
+//      variable, unless the same one is already queued. Reduction then
+//      visits the levels bottom up and makes the node of each request
+//      from the results of its cofactors. Each pass works through one
+//      level's nodes and unique table at a time, rather than jumping
+//      between levels at every step as applyIter() does, which pays on
+//      operands too large for the caches.
+template <CacheOp OP>
+BDD
+BddImpl::applyBfs(BDD f, BDD g)
+{
+  BDD rtn = _nullNode;
+  ApplyFrame root{f, g, _nullNode, _nullNode, 0, 0, 0, false};
+  if (applyStart<OP, false>(root, rtn)) {
+    return rtn;
+  } // if settled
+
+  BfsQueues queues;
+  queues._levels.resize(_maxIndex + 1);
+  bfsRequest(queues, root);
+  for (BddIndex level = root._index; level <= _maxIndex; ++level) {
+    bfsExpand<OP>(queues, level);
+  } // for each level down
+  for (BddIndex level = _maxIndex; level >= root._index; --level) {
+    if (!bfsReduce<OP>(queues, level)) {
+      return _nullNode;
+    } // if out of nodes
+  } // for each level up
+
+  return queues._reqs[0]._rtn;
+} // BddImpl::applyBfs
+
+
+//      Function : BddImpl::bfsExpand
+//      Abstract : Split the requests queued on level into their
+//      cofactors. The queues below level grow as new requests are
+//      found. Their nodes are not prefetched as they are not expanded
+//      until the rest of this level has been.
+template <CacheOp OP>
+void
+BddImpl::bfsExpand(BfsQueues &queues, const BddIndex level)
+{
+  for (const uint32_t id : queues._levels[level]) {
+    const BDD f = queues._reqs[id]._f;
+    const BDD g = queues._reqs[id]._g;
+    for (const bool hiSide : {true, false}) {
+      BDD rtn = _nullNode;
+      uint32_t req = BFS_NO_REQ;
+      ApplyFrame frame{cofactor(f, level, hiSide),
+                       cofactor(g, level, hiSide),
+                       _nullNode, _nullNode, 0, 0, 0, false};
+      if (!applyStart<OP, false>(frame, rtn)) {
+        req = bfsRequest(queues, frame);
+      } // if not settled
+      // bfsRequest() may move the requests.
+      BfsRequest &request = queues._reqs[id];
+      (hiSide ? request._hi : request._lo) = rtn;
+      (hiSide ? request._hiReq : request._loReq) = req;
+    } // for each cofactor
+  } // for each request
+} // BddImpl::bfsExpand
+
+
+//      Function : BddImpl::bfsReduce
+//      Abstract : Make the nodes for the requests queued on level. The
+//      results of their cofactors are gathered first so that the
+//      unique table slot of each request can be fetched a few
+//      requests ahead of its insertion. Returns false if out of nodes.
+template <CacheOp OP>
+bool
+BddImpl::bfsReduce(BfsQueues &queues, const BddIndex level)
+{
+  static const size_t LOOKAHEAD = 8;
+
+  const BfsReqIds &ids = queues._levels[level];
+  auto &reqs = queues._reqs;
+  for (const uint32_t id : ids) {
+    BfsRequest &req = reqs[id];
+    size_t cost = 1;
+    if (req._hiReq != BFS_NO_REQ) {
+      req._hi = reqs[req._hiReq]._rtn;
+      cost += reqs[req._hiReq]._cost;
+    } // if
+    if (req._loReq != BFS_NO_REQ) {
+      req._lo = reqs[req._loReq]._rtn;
+      cost += reqs[req._loReq]._cost;
+    } // if
+    req._cost = std::min<size_t>(cost, CACHE_MAX_COST);
+  } // for each request
+
+  for (size_t idx = 0; idx < ids.size(); ++idx) {
+    if (idx + LOOKAHEAD < ids.size()) {
+      const BfsRequest &ahead = reqs[ids[idx + LOOKAHEAD]];
+      if (ahead._hi != ahead._lo) {
+        prefetchUniqTbl(level, ahead._hi, ahead._lo);
+      } // if a node is needed
+    } // if
+    BfsRequest &req = reqs[ids[idx]];
+    req._rtn = makeNode(level, req._hi, req._lo);
+    if (isNull(req._rtn)) {
+      return false;
+    } // if out of nodes
+    insertCache(OP, req._f, req._g, _nullNode, req._rtn, req._cost);
+  } // for each request
+
+  return true;
+} // BddImpl::bfsReduce
+
+
+//      Function : BddImpl::bfsRequest
+//      Abstract : Return the id of the request for the operands of
+//      frame, queueing a new one on its level if there is none.
+uint32_t
+BddImpl::bfsRequest(BfsQueues &queues, const ApplyFrame &frame)
+{
+  auto &reqs = queues._reqs;
+  auto &hash = queues._hash;
+  if (2 * (reqs.size() + 1) > hash.size()) {
+    hash.assign(std::max<size_t>(MIN_CACHE_SZ, 2 * hash.size()), BFS_NO_REQ);
+    const size_t mask = hash.size() - 1;
+    for (uint32_t id = 0; id < reqs.size(); ++id) {
+      size_t hdx = bfsHash(reqs[id]._f, reqs[id]._g) & mask;
+      while (hash[hdx] != BFS_NO_REQ) {
+        hdx = (hdx + 1) & mask;
+      } // while occupied
+      hash[hdx] = id;
+    } // for each request
+  } // if load too high
+
+  const size_t mask = hash.size() - 1;
+  size_t hdx = bfsHash(frame._f, frame._g) & mask;
+  for (; hash[hdx] != BFS_NO_REQ; hdx = (hdx + 1) & mask) {
+    const BfsRequest &req = reqs[hash[hdx]];
+    if (req._f == frame._f && req._g == frame._g) {
+      return hash[hdx];
+    } // if found
+  } // for occupied slots
+
+  const uint32_t id = reqs.size();
+  hash[hdx] = id;
+  reqs.push_back({frame._f, frame._g, _nullNode, _nullNode,
+                  BFS_NO_REQ, BFS_NO_REQ, 0, _nullNode});
+  queues._levels[frame._index].push_back(id);
+
+  return id;
+} // BddImpl::bfsRequest
+
 //      Function : BddImpl::restrict
 //      Abstract : Computes the cofactor of f w.r.t. c.
 BDD
 BddImpl::restrict(BDD f, BDD c)
 {
-  BDD rtn = restrictRec(f, c);
+  BDD rtn = restrictIter(f, c);
   if (isNull(rtn) && _gcLock == 0) {
     gc(true, false);
-    rtn = restrictRec(f, c);
+    rtn = restrictIter(f, c);
   } // if
 
   return rtn;
@@ -113,6 +405,215 @@ BddImpl::compose(BDD f, BddVar x, BDD g)
 } // BddImpl::compose
 
 
+//      Function : BddImpl::vectorCompose
+//      Abstract : Replace each variable x of subst with subst[x] in
+//      the BDDs fs at once. Each node of fs down to the lowest
+//      variable replaced is rebuilt once, after its children, and memo
+//      maps it to its result, so memo is the computed cache of this
+//      substitution and is shared by all of fs. A node whose variable
+//      is replaced by a positive literal above the results of its
+//      children is made directly with the index of the literal, so a
+//      rename that preserves the order just relabels the nodes. A node
+//      whose variable is kept is its own result if its children are,
+//      is made directly if its variable is above their results and is
+//      made with ite() otherwise. Nodes below every replaced variable
+//      are their own results. The results are null if a replacement
+//      is null or the manager runs out of nodes. The nodes of fs are
+//      held by id without references, so they are walked again after
+//      the gc before a retry, which may compact and move them.
+BDDVec
+BddImpl::vectorCompose(const BDDVec &fs, const std::map<BddVar, BDD> &subst)
+{
+  BDDVec byIndex(_maxIndex + 1, _nullNode);
+  BddIndexVec litIndex(_maxIndex + 1, 0);
+  BddIndex lowest = 0;
+  for (const auto &[var, g] : subst) {
+    if (isNull(g)) {
+      return BDDVec(fs.size(), _nullNode);
+    } else if (auto it = _var2Index.find(var);
+               it != _var2Index.end()) {
+      byIndex[it->second] = g;
+      litIndex[it->second] = isPosLit(g) ? getIndex(g) : 0;
+      lowest = std::max(lowest, it->second);
+    } // if fs may depend on var
+  } // for each replacement
+
+  std::unordered_map<BDD, BDD> memo;
+  BDDVec nodes;
+  auto collect = [&fs, &memo, &nodes, lowest, this]() {
+    memo.clear();
+    nodes.clear();
+    for (BDD f : fs) {
+      if (isNull(f)) {
+        continue;
+      } // if
+      walkNodes(f, [&memo, &nodes, lowest, this](BDD g) {
+        g = abs(g);
+        if (index(g) > lowest) {
+          return false;
+        } else if (!memo.emplace(g, _nullNode).second) {
+          return false;
+        } // if kept or visited
+        nodes.push_back(g);
+        return true;
+      });
+    } // for each BDD
+
+    // Children are below their parents, so bottom up is by index.
+    std::sort(nodes.begin(), nodes.end(), [this](BDD a, BDD b) {
+      return getIndex(a) > getIndex(b);
+    });
+  }; // collect
+
+  auto result = [&memo, lowest, this](BDD g) {
+    if (index(g) > lowest) {
+      return g;
+    } // if kept
+    BDD r = memo[abs(g)];
+    return isNegPhase(g) ? invert(r) : r;
+  }; // result
+
+  BDDVec rtn;
+  for (int attempt = 0; attempt < 2 && rtn.empty(); ++attempt) {
+    if (attempt > 0) {
+      if (_gcLock > 0) {
+        break;
+      } // if
+      gc(true, false);
+    } // if retry
+
+    lockGC();
+    collect();
+    bool done = true;
+    for (BDD g : nodes) {
+      const BddIndex idx = getIndex(g);
+      const BDD hi = result(getHi(g));
+      const BDD lo = result(getLo(g));
+      BDD r = _nullNode;
+      if (BddIndex to = litIndex[idx];
+          to && to < minIndex(hi, lo)) {
+        r = makeNode(to, hi, lo);
+      } else if (BDD sub = byIndex[idx];
+                 !isNull(sub)) {
+        r = ite(sub, hi, lo);
+      } else if (hi == getHi(g) && lo == getLo(g)) {
+        r = g;
+      } else if (idx < minIndex(hi, lo)) {
+        r = makeNode(idx, hi, lo);
+      } else if (BDD lit = getIthLit(idx);
+                 !isNull(lit)) {
+        r = ite(lit, hi, lo);
+      } // if
+      if (isNull(r)) {
+        done = false;
+        break;
+      } // if out of nodes
+      memo[g] = r;
+    } // for bottom up
+    if (done) {
+      for (BDD f : fs) {
+        rtn.push_back(isNull(f) ? _nullNode : result(f));
+      } // for each BDD
+    } // if
+    unlockGC();
+  } // for each attempt
+
+  if (rtn.empty()) {
+    rtn.resize(fs.size(), _nullNode);
+  } // if failed
+  return rtn;
+} // BddImpl::vectorCompose
+
+
+//      Function : BddImpl::transfer
+//      Abstract : Copy the BDDs fs of manager src into this one.
+//      Variables are matched by id, so each copy is the same function
+//      whatever the two orders. Each node reachable from fs is copied
+//      once, after its children, and memo maps it to its copy. A node
+//      whose variable is above the copies of its children here is made
+//      directly and any other with ite(). Variables new to this manager
+//      are added in the order they have in src. The copies are null if
+//      this manager runs out of nodes.
+BDDVec
+BddImpl::transfer(const BddImpl &src, const BDDVec &fs)
+{
+  std::unordered_map<BDD, BDD> memo;
+  BDDVec nodes;
+  memo[src._oneNode] = _oneNode;
+  for (BDD f : fs) {
+    if (src.isNull(f)) {
+      continue;
+    } // if
+    src.walkNodes(f, [&src, &memo, &nodes, this](BDD g) {
+      g = src.abs(g);
+      if (!memo.emplace(g, _nullNode).second) {
+        return false;
+      } // if constant or visited
+      nodes.push_back(g);
+      return true;
+    });
+  } // for each BDD
+
+  // Children are below their parents, so bottom up is by index.
+  std::sort(nodes.begin(), nodes.end(), [&src](BDD a, BDD b) {
+    return src.getIndex(a) > src.getIndex(b);
+  });
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+    if (BddVar var = src.getBddVar(*it);
+        _var2Index.count(var) == 0) {
+      getLit(var);
+    } // if new variable
+  } // for top down
+
+  auto copy = [&src, &memo, this](BDD g) {
+    BDD c = memo[src.abs(g)];
+    return src.isNegPhase(g) ? invert(c) : c;
+  }; // copy
+
+  BDDVec rtn;
+  for (int attempt = 0; attempt < 2 && rtn.empty(); ++attempt) {
+    if (attempt > 0) {
+      if (_gcLock > 0) {
+        break;
+      } // if
+      gc(true, false);
+    } // if retry
+
+    lockGC();
+    bool done = true;
+    for (BDD g : nodes) {
+      const BddVar var = src.getBddVar(g);
+      const BddIndex idx = _var2Index[var];
+      const BDD hi = copy(src.getHi(g));
+      const BDD lo = copy(src.getLo(g));
+      BDD r = _nullNode;
+      if (idx < minIndex(hi, lo)) {
+        r = makeNode(idx, hi, lo);
+      } else if (BDD lit = getLit(var);
+                 !isNull(lit)) {
+        r = ite(lit, hi, lo);
+      } // if
+      if (isNull(r)) {
+        done = false;
+        break;
+      } // if out of nodes
+      memo[g] = r;
+    } // for bottom up
+    if (done) {
+      for (BDD f : fs) {
+        rtn.push_back(src.isNull(f) ? _nullNode : copy(f));
+      } // for each BDD
+    } // if
+    unlockGC();
+  } // for each attempt
+
+  if (rtn.empty()) {
+    rtn.resize(fs.size(), _nullNode);
+  } // if failed
+  return rtn;
+} // BddImpl::transfer
+
+
 //      Function : BddImpl::andExists
 //      Abstract : Compute the relational product of f and g w.r.t. c.
 BDD
@@ -132,67 +633,124 @@ BddImpl::andExists(const BDD f, const BDD g, const BDD c)
 
 
 //      Function : BddImpl::andExists2
-//      Abstract : Recursive step.
+//      Abstract : Compute the relational product without retry.
 BDD
 BddImpl::andExists2(BDD f, BDD g, BDD c)
 {
-  orderOps(f, g);
+  return applyTop<CACHE_ANDEXISTS>(f, g, c);
+} // BddImpl::andExists2
 
-  BDD rtn = andExistsTerminal(f, g, c);
 
-  if (rtn) {
-    return rtn;
+//      Function : BddImpl::applyExists
+//      Abstract : Compute Exists(c, f op g) without building f op g.
+BDD
+BddImpl::applyExists(const BDD f, const BDD g, const BDD c, const BddOp op)
+{
+  BDD rtn = _nullNode;
+  if (!isNull(f) && !isNull(g) && !isNull(c)) {
+    lockGC();
+    rtn = applyExists2(f, g, c, op);
+    unlockGC();
+    if (isNull(rtn) && _gcLock == 0) {
+      gc(true, false);
+      rtn = applyExists2(f, g, c, op);
+    } // if
   } // if
 
-  rtn = getAndExistsCache(f, g, c);
-  if (!rtn) {
-    _cacheStats.incCompMiss();
-    BddIndex index = minIndex(f, g);
-    BddIndex cdx = getIndex(c);
-    while (cdx < index) {
-      c = getHi(c);
-      cdx = getIndex(c);
-    } // while
+  return rtn;
+} // BddImpl::applyExists
 
-    if (BDD lo = andExists2(restrict0(f, index),
-                            restrict0(g, index),
-                            restrict1(c, index));
-        lo) {
-      if (index == cdx && isOne(lo)) {
-        rtn = _oneNode;
-      } else if (BDD hi = andExists2(restrict1(f, index),
-                                     restrict1(g, index),
-                                     restrict1(c, index));
-                 hi) {
-        rtn = (index == cdx)
-          ? or2(lo, hi)
-          : makeNode(index, hi, lo);
-        insertAndExistsCache(f, g, c, rtn);
-      } // if lo is one
-    } // if lo computed
-  } else {
-    _cacheStats.incCompHit();
-  } // if
+
+//      Function : BddImpl::applyExists2
+//      Abstract : Compute Exists(c, f op g) without retry. The ops
+//      that reduce to an and are done by andExists and those that
+//      reduce to an or by quantifying each operand.
+BDD
+BddImpl::applyExists2(BDD f, BDD g, BDD c, BddOp op)
+{
+  switch (op) {
+   case AND:
+    return applyTop<CACHE_ANDEXISTS>(f, g, c);
+   case NOR:
+    return applyTop<CACHE_ANDEXISTS>(invert(f), invert(g), c);
+   case XOR:
+    return applyTop<CACHE_XOREXISTS>(f, g, c);
+   case XNOR:
+    return applyTop<CACHE_XOREXISTS>(f, invert(g), c);
+   case OR:
+    break;
+   case NAND:
+    f = invert(f);
+    g = invert(g);
+    break;
+   case IMPL:
+    f = invert(f);
+    break;
+   default:
+    assert(false);
+  } // switch
+
+  BDD rtn = _nullNode;
+  if (BDD f1 = applyTop<CACHE_EXISTS>(f, _oneNode, c);
+      f1) {
+    if (BDD g1 = applyTop<CACHE_EXISTS>(g, _oneNode, c);
+        g1) {
+      rtn = apply2(f1, g1, OR);
+    } // if g1
+  } // if f1
 
   return rtn;
-} // BddImpl::andExists2
+} // BddImpl::applyExists2
 
 
-//      Function : BddImpl::andExistsTerminal
-//      Abstract : Check for terminating condition.
+//      Function : BddImpl::exists
+//      Abstract : Compute Exists(c, f).
 BDD
-BddImpl::andExistsTerminal(BDD f, BDD g, BDD c)
+BddImpl::exists(const BDD f, const BDD c)
 {
-  if (isOne(c)) {
-    return and2(f, g);
-  } else if (isZero(f)) {
-    return _zeroNode;
-  } else if (f == invert(g)) {
-    return _zeroNode;
+  return quantify<CACHE_EXISTS>(f, c);
+} // BddImpl::exists
+
+
+//      Function : BddImpl::forall
+//      Abstract : Compute Forall(c, f) as the dual of exists, whose
+//      computed cache entries it shares.
+BDD
+BddImpl::forall(const BDD f, const BDD c)
+{
+  return invert(quantify<CACHE_EXISTS>(invert(f), c));
+} // BddImpl::forall
+
+
+//      Function : BddImpl::unique
+//      Abstract : Compute the Boolean difference of f with respect to
+//      each variable of c in turn.
+BDD
+BddImpl::unique(const BDD f, const BDD c)
+{
+  return quantify<CACHE_UNIQUE>(f, c);
+} // BddImpl::unique
+
+
+//      Function : BddImpl::quantify
+//      Abstract : Compute OP(f, 1, c) with retry after gc if null.
+template <CacheOp OP>
+BDD
+BddImpl::quantify(const BDD f, const BDD c)
+{
+  BDD rtn = _nullNode;
+  if (!isNull(f) && !isNull(c)) {
+    lockGC();
+    rtn = applyTop<OP>(f, _oneNode, c);
+    unlockGC();
+    if (isNull(rtn) && _gcLock == 0) {
+      gc(true, false);
+      rtn = applyTop<OP>(f, _oneNode, c);
+    } // if
   } // if
 
-  return _nullNode;
-} // BddImpl::andExistsTerminal
+  return rtn;
+} // BddImpl::quantify
 
 
 //      Function : BddImpl::covers
@@ -395,43 +953,142 @@ BddImpl::oneCube(BDD f)
 } // BddImpl::oneCube
 
 
-//      Function : BddImpl::and2
-//      Abstract : Computes f*g.
-BDD
-BddImpl::and2(BDD f, BDD g)
+//      Function : BddImpl::satCount
+//      Abstract : Return the number of assignments to nvars variables
+//      that satisfy each of fs as a double.
+std::vector<double>
+BddImpl::satCount(const BDDVec &fs, size_t nvars)
 {
-  orderOps(f, g);
+  return countMinterms<double>(fs, nvars);
+} // BddImpl::satCount
 
-  // Terminal cases.
-  if (isOne(f)) {
-    return g;
-  } else if (isZero(f)) {
-    return _zeroNode;
-  } else if (f == g) {
-    return f;
-  } else if (f == invert(g)) {
-    return _zeroNode;
-  } // if
 
-  BDD rtn = getAndCache(f, g);
-  if (!rtn) {
-    _cacheStats.incCompMiss();
-    BddIndex index = minIndex(f, g);
-    if (BDD hi = and2(restrict1(f, index),
-                      restrict1(g, index));
-        hi) {
-      if (BDD lo = and2(restrict0(f, index),
-                        restrict0(g, index));
-          lo) {
-        rtn = makeNode(index, hi, lo);
-        insertAndCache(f, g, rtn);
-      } // if lo
-    } // if hi
-  } else {
-    _cacheStats.incCompHit();
-  } // if
+//      Function : BddImpl::satCount128
+//      Abstract : Return the number of assignments to nvars variables
+//      that satisfy each of fs as a saturating 128-bit integer.
+std::vector<BddCount128>
+BddImpl::satCount128(const BDDVec &fs, size_t nvars)
+{
+  return countMinterms<BddCount128>(fs, nvars);
+} // BddImpl::satCount128
+
 
+//      Function : BddImpl::satCountStr
+//      Abstract : Return the exact number of assignments to nvars
+//      variables that satisfy each of fs in decimal.
+std::vector<std::string>
+BddImpl::satCountStr(const BDDVec &fs, size_t nvars)
+{
+  std::vector<std::string> rtn;
+  for (const auto &count : countMinterms<BigCount>(fs, nvars)) {
+    rtn.push_back(countStr(count));
+  } // for each count
   return rtn;
+} // BddImpl::satCountStr
+
+
+//      Function : BddImpl::countMinterms
+//      Abstract : Count the assignments to nvars variables that satisfy
+//      each of fs. The variables must include the support of all of
+//      them. If nvars is less than its size, the counts are not defined
+//      and every one is zero. A null function counts as zero. The
+//      levels in the support are numbered from the top so that the
+//      count of a node is over the support variables below it. Nodes
+//      are counted after their children in a walk with an explicit
+//      stack, so deep orders do not recurse. f and ~f are counted
+//      apart and only if reached, so every count is that of a cofactor
+//      of one of fs and is no larger than its count. The 128-bit counts
+//      overflow only when a result does. Each node is counted once for
+//      all of fs.
+template <class Count>
+std::vector<Count>
+BddImpl::countMinterms(const BDDVec &fs, size_t nvars)
+{
+  BitVec suppVec(_maxIndex + 1, false);
+  size_t numNodes = 0;
+  for (BDD f : fs) {
+    if (!isNull(f)) {
+      walkNodes(f, [this, &suppVec, &numNodes](BDD g) {
+        if (isConstant(g) || nodeMarked(g, 1)) {
+          return false;
+        } // if terminal or visited
+        markNode(g, 1);
+        suppVec[getIndex(g)] = true;
+        ++numNodes;
+        return true;
+      });
+    } // if
+  } // for each function
+  for (BDD f : fs) {
+    if (!isNull(f)) {
+      unmarkNodes(f, 1);
+    } // if
+  } // for each function
+  std::vector<int> rank(_maxIndex + 1, 0);
+  int numSupp = 0;
+  for (BddIndex idx = 1; idx <= _maxIndex; ++idx) {
+    if (suppVec[idx]) {
+      rank[idx] = numSupp++;
+    } // if
+  } // for each level
+  if (nvars < size_t(numSupp)) {
+    return std::vector<Count>(fs.size(), Count(0));
+  } // if too few variables
+  auto rankOf = [this, &rank, numSupp](BDD g) {
+    return isConstant(g) ? numSupp : rank[getIndex(g)];
+  }; // rankOf
+
+  // A node is on the stack twice: once to visit its children and once,
+  // beneath them, to be counted when they are done.
+  std::unordered_map<BDD, Count> counts;
+  counts.reserve(numNodes);
+  auto countOf = [this, &counts](BDD g) {
+    return isConstant(g) ? Count(isOne(g) ? 1 : 0) : counts.find(g)->second;
+  }; // countOf
+  std::vector<std::pair<BDD, bool>> stack;
+  std::vector<Count> rtn;
+  for (BDD f : fs) {
+    if (isNull(f)) {
+      rtn.push_back(Count(0));
+      continue;
+    } // if
+
+    stack.emplace_back(f, false);
+    while (!stack.empty()) {
+      auto [g, childrenDone] = stack.back();
+      stack.pop_back();
+      const BDD hi = getXHi(g);
+      const BDD lo = getXLo(g);
+      if (childrenDone) {
+        const int level = rankOf(g);
+        Count count = countOf(hi);
+        countShift(count, rankOf(hi) - level - 1);
+        Count loCount = countOf(lo);
+        countShift(loCount, rankOf(lo) - level - 1);
+        countAdd(count, loCount);
+        counts[g] = std::move(count);
+      } else if (!isConstant(g) && counts.emplace(g, Count(0)).second) {
+        stack.emplace_back(g, true);
+        stack.emplace_back(hi, false);
+        stack.emplace_back(lo, false);
+      } // if
+    } // while nodes to count
+
+    Count count = countOf(f);
+    countShift(count, rankOf(f) + int(nvars) - numSupp);
+    rtn.push_back(count);
+  } // for each function
+
+  return rtn;
+} // BddImpl::countMinterms
+
+
+//      Function : BddImpl::and2
+//      Abstract : Computes f*g.
+BDD
+BddImpl::and2(BDD f, BDD g)
+{
+  return applyIter<CACHE_AND>(f, g, _nullNode);
 } // BddImpl::and2
 
 
@@ -440,38 +1097,7 @@ BddImpl::and2(BDD f, BDD g)
 BDD
 BddImpl::xor2(BDD f, BDD g)
 {
-  orderOps(f, g);
-
-  // Terminal cases.
-  if (isOne(f)) {
-    return invert(g);
-  } else if (isZero(f)) {
-    return g;
-  } else if (f == g) {
-    return _zeroNode;
-  } else if (f == invert(g)) {
-    return _oneNode;
-  } // if
-
-  BDD rtn = getXorCache(f, g);
-  if (!rtn) {
-    _cacheStats.incCompMiss();
-    BddIndex index = minIndex(f, g);
-    if (BDD hi = xor2(restrict1(f, index),
-                      restrict1(g, index));
-        hi) {
-      if (BDD lo = xor2(restrict0(f, index),
-                        restrict0(g, index));
-          lo) {
-        rtn = makeNode(index, hi, lo);
-        insertXorCache(f, g, rtn);
-      } // if lo
-    } // if hi
-  } else {
-    _cacheStats.incCompHit();
-  } // if
-
-  return rtn;
+  return applyIter<CACHE_XOR>(f, g, _nullNode);
 } // BddImpl::xor2
 
 
@@ -489,9 +1115,9 @@ BddImpl::andConstant(BDD f, BDD g)
     return rtn;
   } // if
 
-  rtn = getAndCache(f, g);
+  rtn = getCache(CACHE_AND, f, g, _nullNode);
   if (!rtn) {
-    _cacheStats.incCompMiss();
+    const size_t misses = _compMisses;
     BddIndex index = minIndex(f, g);
     if (BDD hi = andConstant(restrict1(f, index),
                              restrict1(g, index));
@@ -500,7 +1126,7 @@ BddImpl::andConstant(BDD f, BDD g)
                                restrict0(g, index));
           isConstant(lo)) {
         if (hi == lo) {
-          insertAndCache(f, g, hi);
+          insertCache(CACHE_AND, f, g, _nullNode, hi, _compMisses - misses);
           return hi;
         } else {
           return _nullNode;
@@ -508,7 +1134,6 @@ BddImpl::andConstant(BDD f, BDD g)
       } // if lo
     } // if hi
   } else {
-    _cacheStats.incCompHit();
     rtn = isConstant(rtn) ? rtn : _nullNode;
   } // if
 
@@ -548,43 +1173,450 @@ BddImpl::ite(BDD f, BDD g, BDD h)
   assert(f >= 2);
   assert(g >= 2);
   assert(h >= 2);
-  bool inv = stdTrip(f, g, h);
+  return applyTop<CACHE_ITE>(f, g, h);
+} // BddImpl::ite
+
+
+//      Function : BddImpl::applyIter
+//      Abstract : Computes OP(f,g,h) without recursion. Each frame on
+//      _applyStack is an operation waiting for the results of its two
+//      cofactors, which are computed in turn. The result of the last
+//      frame to finish is passed up in rtn. Terminal cases and cache
+//      hits are settled by applyStart() without pushing a frame. The
+//      stack belongs to the manager so that its memory is reused, and
+//      frames below base belong to an enclosing call, such as the one
+//      that reached the or2() in a quantified step. With
+//      PAR set, it runs as worker w of a parallel operation, on w's
+//      stack and with the shared forms of the tables.
+template <CacheOp OP, bool PAR>
+BDD
+BddImpl::applyIter(BDD f, BDD g, BDD h, BddWorker *w)
+{
   BDD rtn = _nullNode;
+  ApplyFrame next{f, g, h, _nullNode, 0, 0, 0, false};
+  if (applyStart<OP, true, PAR>(next, rtn, w)) {
+    return rtn;
+  } // if settled
+
+  ApplyStack &stack = PAR ? w->_stack : _applyStack;
+  const size_t base = stack.size();
+  stack.push_back(next);
+  while (stack.size() > base) {
+    ApplyFrame *top = &stack.back();
+    if (top->_step > 0 && isNull(rtn)) {
+      stack.resize(base);
+      return _nullNode;
+    } else if (top->_step == 2) {
+      // Popped before finishing since or2() may push frames.
+      ApplyFrame done = *top;
+      stack.pop_back();
+      rtn = applyFinish<OP, PAR>(done, rtn, w);
+      continue;
+    } else if (top->_step == 1) {
+      top->_first = rtn;
+      if (quantOp(OP) && OP != CACHE_UNIQUE && top->_flag && isOne(rtn)) {
+        // The lo cofactor is one, so the disjunction is too.
+        stack.pop_back();
+        continue;
+      } // if done early
+    } // if
 
-  if (isOne(f)) {
-    rtn = g;
-  } else if (g == h) {
-    rtn = g;
-  } else if (isOne(g) && isZero(h)) {
-    rtn = f;
+    // The first cofactor of a quantifier is lo. Otherwise it is hi.
+    const bool hiSide = (top->_step == 0) != quantOp(OP);
+    const BddIndex index = top->_index;
+    ++top->_step;
+    f = cofactor(top->_f, index, hiSide);
+    g = cofactor(top->_g, index, hiSide);
+    if constexpr (OP == CACHE_ITE) {
+      h = cofactor(top->_h, index, hiSide);
+    } else if constexpr (quantOp(OP)) {
+      h = restrict1(top->_h, index);
+    } // if
+    next = {f, g, h, _nullNode, 0, 0, 0, false};
+    if (!applyStart<OP, true, PAR>(next, rtn, w)) {
+      stack.push_back(next);
+    } // if not settled
+  } // while frames
+
+  return rtn;
+} // BddImpl::applyIter
+
+
+//      Function : BddImpl::applyStart
+//      Abstract : Put the operands of frame in standard form and
+//      return true with the result in rtn if it is a terminal case or
+//      in the computed cache. Otherwise, set up the frame to be
+//      expanded, start fetching what its cofactors will need unless
+//      PREFETCH is false and return false. A null result means the
+//      operation is to be abandoned.
+template <CacheOp OP, bool PREFETCH, bool PAR>
+inline bool
+BddImpl::applyStart(ApplyFrame &frame, BDD &rtn, BddWorker *w)
+{
+  BDD &f = frame._f;
+  BDD &g = frame._g;
+  BDD &h = frame._h;
+  if constexpr (OP == CACHE_AND) {
+    orderOps(f, g);
+    if (isOne(f)) {
+      rtn = g;
+      return true;
+    } else if (isZero(f) || f == invert(g)) {
+      rtn = _zeroNode;
+      return true;
+    } else if (f == g) {
+      rtn = f;
+      return true;
+    } // if
+  } else if constexpr (OP == CACHE_XOR) {
+    orderOps(f, g);
+    if (isOne(f)) {
+      rtn = invert(g);
+      return true;
+    } else if (isZero(f)) {
+      rtn = g;
+      return true;
+    } else if (f == g) {
+      rtn = _zeroNode;
+      return true;
+    } else if (f == invert(g)) {
+      rtn = _oneNode;
+      return true;
+    } // if
+  } else if constexpr (OP == CACHE_ITE) {
+    frame._flag = stdTrip(f, g, h);
+    if (isOne(f) || g == h) {
+      rtn = frame._flag ? invert(g) : g;
+      return true;
+    } else if (isOne(g) && isZero(h)) {
+      rtn = frame._flag ? invert(f) : f;
+      return true;
+    } // if
+  } else if constexpr (OP == CACHE_ANDEXISTS) {
+    orderOps(f, g);
+    // With g constant, so is f, which orderOps() puts first, and there
+    // is nothing left to quantify.
+    if (isOne(h) || isConstant(g)) {
+      rtn = applyIter<CACHE_AND, PAR>(f, g, _nullNode, w);
+      return true;
+    } else if (isZero(f) || f == invert(g)) {
+      rtn = _zeroNode;
+      return true;
+    } // if
+  } else if constexpr (OP == CACHE_XOREXISTS) {
+    orderOps(f, g);
+    if (isOne(h)) {
+      rtn = applyIter<CACHE_XOR, PAR>(f, g, _nullNode, w);
+      return true;
+    } else if (f == g) {
+      rtn = _zeroNode;
+      return true;
+    } else if (f == invert(g)) {
+      rtn = _oneNode;
+      return true;
+    } else if (isConstant(f)) {
+      rtn = applyIter<CACHE_EXISTS, PAR>(isOne(f) ? invert(g) : g,
+                                         _oneNode, h, w);
+      return true;
+    } // if
+  } else if constexpr (OP == CACHE_EXISTS) {
+    if (isOne(h) || isConstant(f)) {
+      rtn = f;
+      return true;
+    } // if
   } else {
-    rtn = getIteCache(f, g, h);
-    if (! rtn) {
-      _cacheStats.incCompMiss();
-      BddIndex index = minIndex(f, g, h);
-      BDD hi = ite(restrict1(f, index),
-                   restrict1(g, index),
-                   restrict1(h, index));
-      if (hi) {
-        BDD lo = ite(restrict0(f, index),
-                     restrict0(g, index),
-                     restrict0(h, index));
-        if (lo) {
-          rtn = makeNode(index, hi, lo);
-          insertIteCache(f, g, h, rtn);
-        } // if valid else node
-      } // if valid then node
-    } else {
-      _cacheStats.incCompHit();
-    } // if not in cache
-  } // test for terminal cases
+    static_assert(OP == CACHE_UNIQUE);
+    if (isOne(h)) {
+      rtn = f;
+      return true;
+    } else if (isConstant(f)) {
+      rtn = _zeroNode;
+      return true;
+    } // if
+  } // if
 
-  if (rtn && inv) {
+  if constexpr (PAR) {
+    rtn = getCacheShared(*w, OP, f, g, h);
+  } else {
+    rtn = getCache(OP, f, g, h);
+  } // if
+  if (rtn) {
+    rtn = (OP == CACHE_ITE && frame._flag) ? invert(rtn) : rtn;
+    return true;
+  } // if hit
+
+  if constexpr (PAR) {
+    if (_parPause.load(std::memory_order_relaxed)) {
+      pauseParallel();
+    } // if
+    if (_parAbort.load(std::memory_order_relaxed)) {
+      rtn = _nullNode;
+      return true;
+    } // if abandoned
+    frame._misses = w->_misses;
+  } else {
+    if (_compMisses > _applyLimit) {
+      rtn = _nullNode;
+      return true;
+    } // if over budget
+    frame._misses = _compMisses;
+  } // if
+  frame._step = 0;
+  if constexpr (OP == CACHE_ITE) {
+    frame._index = minIndex(f, g, h);
+  } else {
+    frame._index = minIndex(f, g);
+  } // if
+  if constexpr (OP == CACHE_UNIQUE) {
+    // The difference of f with respect to a variable not in its
+    // support is zero.
+    if (getIndex(h) < frame._index) {
+      rtn = _zeroNode;
+      return true;
+    } // if
+    frame._flag = (getIndex(h) == frame._index);
+  } else if constexpr (quantOp(OP)) {
+    // Variables of c above f and g are not in their support. The
+    // result is cached under the reduced c.
+    while (getIndex(h) < frame._index) {
+      h = getHi(h);
+    } // while
+    frame._flag = (getIndex(h) == frame._index);
+  } // if
+  if constexpr (PREFETCH) {
+    applyPrefetch<OP>(frame);
+  } // if
+
+  return false;
+} // BddImpl::applyStart
+
+
+//      Function : BddImpl::applyFinish
+//      Abstract : Combine the cofactor results of frame, cache the
+//      result and return it. second is the result of the cofactor
+//      computed last.
+template <CacheOp OP, bool PAR>
+inline BDD
+BddImpl::applyFinish(const ApplyFrame &frame, const BDD second, BddWorker *w)
+{
+  BDD rtn;
+  if constexpr (PAR) {
+    if (OP == CACHE_UNIQUE && frame._flag) {
+      rtn = applyIter<CACHE_XOR, true>(frame._first, second, _nullNode, w);
+    } else if (quantOp(OP) && frame._flag) {
+      rtn = invert(applyIter<CACHE_AND, true>(invert(frame._first),
+                                              invert(second),
+                                              _nullNode, w));
+    } else if (quantOp(OP)) {
+      rtn = makeNodeShared(*w, frame._index, second, frame._first);
+    } else {
+      rtn = makeNodeShared(*w, frame._index, frame._first, second);
+    } // if
+    if (rtn) {
+      insertCacheShared(*w, OP, frame._f, frame._g, frame._h, rtn,
+                        w->_misses - frame._misses);
+    } // if
+  } else {
+    if constexpr (OP == CACHE_UNIQUE) {
+      rtn = (frame._flag
+             ? xor2(frame._first, second)
+             : makeNode(frame._index, second, frame._first));
+    } else if constexpr (quantOp(OP)) {
+      rtn = (frame._flag
+             ? or2(frame._first, second)
+             : makeNode(frame._index, second, frame._first));
+    } else {
+      rtn = makeNode(frame._index, frame._first, second);
+    } // if
+    if (rtn) {
+      insertCache(OP, frame._f, frame._g, frame._h, rtn,
+                  _compMisses - frame._misses);
+    } // if
+  } // if
+  if (OP == CACHE_ITE && frame._flag) {
     rtn = invert(rtn);
-  } // invert?
+  } // if
 
   return rtn;
-} // BddImpl::ite
+} // BddImpl::applyFinish
+
+
+//      Function : BddImpl::applyPrefetch
+//      Abstract : Start loading the nodes of the cofactors of frame
+//      and, for and and xor, the cache sets they will be looked up
+//      in. The loads overlap with each other and with the work left
+//      in this frame rather than stalling one at a time as the next
+//      frames reach them.
+template <CacheOp OP>
+inline void
+BddImpl::applyPrefetch(const ApplyFrame &frame)
+{
+  const BddIndex top = frame._index;
+  BDD cof[2][2] = {{frame._f, frame._g}, {frame._f, frame._g}};
+  for (size_t arg = 0; arg < 2; ++arg) {
+    if (BDD f = cof[0][arg];
+        index(f) == top) {
+      cof[0][arg] = getXHi(f);
+      cof[1][arg] = getXLo(f);
+      prefetch(getNodePtr(cof[0][arg]));
+      prefetch(getNodePtr(cof[1][arg]));
+    } // if split
+  } // for each operand
+
+  if constexpr (OP == CACHE_ITE) {
+    if (index(frame._h) == top) {
+      prefetch(getNodePtr(getXHi(frame._h)));
+      prefetch(getNodePtr(getXLo(frame._h)));
+    } // if split
+  } else if constexpr (OP == CACHE_AND || OP == CACHE_XOR) {
+    if (!_compTbl.empty()) {
+      for (const auto &[f, g] : cof) {
+        prefetch(&_compTbl[cacheSetIndex(OP,
+                                         std::min(f, g),
+                                         std::max(f, g),
+                                         _nullNode)]);
+      } // for each cofactor
+    } // if
+  } // if
+} // BddImpl::applyPrefetch
+
+
+//      Function : BddImpl::applyParallel
+//      Abstract : Computes OP(f,g,h) with the worker threads. Returns
+//      null if a worker ran out of room that could not be grown, so
+//      that the caller's gc and retry take over.
+template <CacheOp OP>
+BDD
+BddImpl::applyParallel(BDD f, BDD g, BDD h)
+{
+  prepareParallel();
+  beginParallel();
+  BDD rtn = applyTask<OP>(*_workers[0], f, g, h, 0);
+  endParallel();
+
+  return rtn;
+} // BddImpl::applyParallel
+
+
+//      Function : BddImpl::applyTask
+//      Abstract : Computes OP(f,g,h) as worker w of a parallel
+//      operation at depth steps below its top. The second cofactor is
+//      pushed on w's tasks for another worker to steal while w computes
+//      the first. If it has not been stolen by then, w takes it back.
+//      Otherwise, w steals other work until it is done.
+template <CacheOp OP>
+BDD
+BddImpl::applyTask(BddWorker &w, BDD f, BDD g, BDD h, const size_t depth)
+{
+  if (depth >= _spawnDepth) {
+    return applyIter<OP, true>(f, g, h, &w);
+  } // if deep enough to run alone
+
+  BDD rtn = _nullNode;
+  ApplyFrame frame{f, g, h, _nullNode, 0, 0, 0, false};
+  if (applyStart<OP, true, true>(frame, rtn, &w)) {
+    return rtn;
+  } // if settled
+
+  // The first cofactor of a quantifier is lo. Otherwise it is hi.
+  const bool hiFirst = !quantOp(OP);
+  const BddIndex index = frame._index;
+  BDD h1 = _nullNode;
+  BDD h2 = _nullNode;
+  if constexpr (OP == CACHE_ITE) {
+    h1 = cofactor(frame._h, index, hiFirst);
+    h2 = cofactor(frame._h, index, !hiFirst);
+  } else if constexpr (quantOp(OP)) {
+    h1 = h2 = restrict1(frame._h, index);
+  } // if
+  BddTask task{OP,
+               cofactor(frame._f, index, !hiFirst),
+               cofactor(frame._g, index, !hiFirst),
+               h2, depth + 1, _nullNode, false};
+  {
+    std::lock_guard<std::mutex> lock(w._lock);
+    w._tasks.push_back(&task);
+  }
+
+  BDD first = applyTask<OP>(w,
+                            cofactor(frame._f, index, hiFirst),
+                            cofactor(frame._g, index, hiFirst),
+                            h1, depth + 1);
+
+  bool kept = false;
+  {
+    std::lock_guard<std::mutex> lock(w._lock);
+    if (!w._tasks.empty() && w._tasks.back() == &task) {
+      w._tasks.pop_back();
+      kept = true;
+    } // if not stolen
+  }
+
+  // The lo cofactor of a quantified step being one, the disjunction
+  // is too.
+  const bool settled = (isNull(first) ||
+                        (quantOp(OP) && OP != CACHE_UNIQUE
+                         && frame._flag && isOne(first)));
+  BDD second = _nullNode;
+  if (kept) {
+    if (!settled) {
+      second = applyTask<OP>(w, task._f, task._g, task._h, depth + 1);
+    } // if
+  } else {
+    while (!task._done.load(std::memory_order_acquire)) {
+      if (_parPause.load(std::memory_order_relaxed)) {
+        pauseParallel();
+      } else if (!stealTask(w)) {
+        std::this_thread::yield();
+      } // if nothing to do
+    } // while
+    second = task._rtn;
+  } // if
+
+  if (settled || isNull(second)) {
+    return settled ? first : _nullNode;
+  } // if
+
+  frame._first = first;
+  return applyFinish<OP, true>(frame, second, &w);
+} // BddImpl::applyTask
+
+
+//      Function : BddImpl::runTask
+//      Abstract : Run a task stolen by worker w and mark it done.
+void
+BddImpl::runTask(BddWorker &w, BddTask &task)
+{
+  BDD rtn = _nullNode;
+  switch (task._op) {
+   case CACHE_AND:
+    rtn = applyTask<CACHE_AND>(w, task._f, task._g, task._h, task._depth);
+    break;
+   case CACHE_XOR:
+    rtn = applyTask<CACHE_XOR>(w, task._f, task._g, task._h, task._depth);
+    break;
+   case CACHE_ITE:
+    rtn = applyTask<CACHE_ITE>(w, task._f, task._g, task._h, task._depth);
+    break;
+   case CACHE_ANDEXISTS:
+    rtn = applyTask<CACHE_ANDEXISTS>(w, task._f, task._g, task._h, task._depth);
+    break;
+   case CACHE_XOREXISTS:
+    rtn = applyTask<CACHE_XOREXISTS>(w, task._f, task._g, task._h, task._depth);
+    break;
+   case CACHE_EXISTS:
+    rtn = applyTask<CACHE_EXISTS>(w, task._f, task._g, task._h, task._depth);
+    break;
+   case CACHE_UNIQUE:
+    rtn = applyTask<CACHE_UNIQUE>(w, task._f, task._g, task._h, task._depth);
+    break;
+   default:
+    assert(false);
+  } // switch
+
+  task._rtn = rtn;
+  task._done.store(true, std::memory_order_release);
+} // BddImpl::runTask
 
 
 //      Function : BddImpl::stdTrip
@@ -682,44 +1714,96 @@ BddImpl::stdNegation(BDD &f, BDD &g, BDD &h)
 } // BddImpl::stdNegation
 
 
-//      Function : BddImpl::restrictRec
-//      Abstract : Recursive worker function for restrict().
+//      Function : BddImpl::restrictIter
+//      Abstract : Worker function for restrict(). Runs on _applyStack
+//      like applyIter(), with _g holding the reduced care set. A frame
+//      whose care set is a literal of its top variable has only the
+//      one cofactor that the literal allows, and _flag is set.
 BDD
-BddImpl::restrictRec(BDD f, BDD c)
+BddImpl::restrictIter(BDD f, BDD c)
 {
-  BDD rtn;
-  if (restrictTerminal(f, c, rtn)) {
+  BDD rtn = _nullNode;
+  ApplyFrame next{f, c, _nullNode, _nullNode, 0, 0, 0, false};
+  if (restrictStart(next, rtn)) {
     return rtn;
-  } // if
+  } // if settled
+
+  const size_t base = _applyStack.size();
+  _applyStack.push_back(next);
+  while (_applyStack.size() > base) {
+    ApplyFrame *top = &_applyStack.back();
+    if (top->_step > 0 && isNull(rtn)) {
+      _applyStack.resize(base);
+      return _nullNode;
+    } else if (top->_step == 2 || (top->_step == 1 && top->_flag)) {
+      ApplyFrame done = _applyStack.back();
+      _applyStack.pop_back();
+      if (!done._flag) {
+        rtn = makeNode(done._index, done._first, rtn);
+      } // if both cofactors
+      if (rtn) {
+        insertCache(CACHE_RESTRICT, done._f, done._g, _nullNode, rtn,
+                    _compMisses - done._misses);
+      } // if
+      continue;
+    } else if (top->_step == 1) {
+      top->_first = rtn;
+    } // if
 
-  rtn = getRestrictCache(f, c);
-  if (! rtn) {
-    _cacheStats.incCompMiss();
-    BddIndex fdx = getIndex(f);
-    c = reduce(c, fdx);
-    BDD c1 = restrict1(c, fdx);
-    BDD c0 = restrict0(c, fdx);
-
-    if (isZero(c1)) {
-      rtn = restrictRec(getXLo(f), c0);
-    } else if (isZero(c0)) {
-      rtn = restrictRec(getXHi(f), c1);
+    // reduce() in restrictStart() may push frames, so top is not used
+    // once next is set up.
+    const BddIndex index = top->_index;
+    if (top->_step++ == 1) {
+      next = {getXLo(top->_f), top->_g, _nullNode, _nullNode,
+              0, 0, 0, false};
+    } else if (BDD c1 = restrict1(top->_g, index); isZero(c1)) {
+      next = {getXLo(top->_f), restrict0(top->_g, index), _nullNode,
+              _nullNode, 0, 0, 0, false};
+    } else if (BDD c0 = restrict0(top->_g, index); isZero(c0)) {
+      next = {getXHi(top->_f), c1, _nullNode, _nullNode, 0, 0, 0, false};
     } else {
-      if (BDD r1 = restrictRec(getXHi(f), c);
-          r1) {
-        if (BDD r0 = restrictRec(getXLo(f), c);
-            r0) {
-          rtn = makeNode(fdx, r1, r0);
-        } // if r0
-      } // if r1
-    } // if cube literal
-    insertRestrictCache(f, c, rtn);
-  } else {
-    _cacheStats.incCompHit();
-  } //if
+      next = {getXHi(top->_f), top->_g, _nullNode, _nullNode,
+              0, 0, 0, false};
+    } // if
+    if (!restrictStart(next, rtn)) {
+      _applyStack.push_back(next);
+    } // if not settled
+  } // while frames
 
   return rtn;
-} // BddImpl::restrictRec
+} // BddImpl::restrictIter
+
+
+//      Function : BddImpl::restrictStart
+//      Abstract : Return true with the result in rtn if frame is a
+//      terminal case or in the computed cache. Otherwise, reduce its
+//      care set to the top variable of f, set it up to be expanded and
+//      return false.
+bool
+BddImpl::restrictStart(ApplyFrame &frame, BDD &rtn)
+{
+  if (restrictTerminal(frame._f, frame._g, rtn)) {
+    return true;
+  } // if
+
+  rtn = getCache(CACHE_RESTRICT, frame._f, frame._g, _nullNode);
+  if (rtn) {
+    return true;
+  } // if hit
+
+  frame._misses = _compMisses;
+  frame._index = getIndex(frame._f);
+  frame._g = reduce(frame._g, frame._index);
+  if (isNull(frame._g)) {
+    rtn = _nullNode;
+    return true;
+  } // if out of nodes
+  frame._flag = (isZero(restrict1(frame._g, frame._index))
+                 || isZero(restrict0(frame._g, frame._index)));
+  frame._step = 0;
+
+  return false;
+} // BddImpl::restrictStart
 
 
 //      Function : BddImpl::restrictTerminal
@@ -746,7 +1830,8 @@ BddImpl::restrictTerminal(BDD f, BDD c, BDD &rtn)
 
 //      Function : BddImpl::reduce
 //      Abstract : While the top variable of c is greater than tgt,
-//      perform or-smoothing on it.
+//      perform or-smoothing on it. Returns the null node if that runs
+//      out of nodes.
 BDD
 BddImpl::reduce(BDD f, BddIndex tgt)
 {
@@ -755,6 +1840,9 @@ BddImpl::reduce(BDD f, BddIndex tgt)
     BddIndex f1 = getXHi(f);
     BddIndex f0 = getXLo(f);
     f = apply2(f1, f0, OR);
+    if (isNull(f)) {
+      break;
+    } // if out of nodes
     idx = getIndex(f);
   } // while
 
@@ -763,19 +1851,19 @@ BddImpl::reduce(BDD f, BddIndex tgt)
 
 
 //      Function : BddImpl::fillSupportVec
-//      Abstract : Recursive function for finding function
-//      support.
+//      Abstract : Find the support of f. Uses mark 1 to record
+//      previously visited nodes.
 void
 BddImpl::fillSupportVec(const BDD f, BitVec &suppVec)
 {
-  if (isConstant(f) || nodeMarked(f, 1)) {
-    return;
-  } else {
-    markNode(f, 1);
-    suppVec[getIndex(f)] = true;
-    fillSupportVec(getHi(f), suppVec);
-    fillSupportVec(getLo(f), suppVec);
-  } // if terminal or not
+  walkNodes(f, [this, &suppVec](BDD g) {
+    if (isConstant(g) || nodeMarked(g, 1)) {
+      return false;
+    } // if terminal or visited
+    markNode(g, 1);
+    suppVec[getIndex(g)] = true;
+    return true;
+  });
 } // BddImpl::fillSupportVec
 
 
@@ -786,15 +1874,14 @@ size_t
 BddImpl::countNodes(const BDD f) const
 {
   size_t count = 0;
-  if (nodeUnmarked(f, 1)) {
-    markNode(f, 1);
-    if (! isConstant(f)) {
-      count = (countNodes(getHi(f)) +
-               countNodes(getLo(f)) + 1);
-    } else {
-      count = 1;
-    } // if not constant
-  } // if unmarked
+  walkNodes(f, [this, &count](BDD g) {
+    if (!nodeUnmarked(g, 1)) {
+      return false;
+    } // if visited
+    markNode(g, 1);
+    ++count;
+    return !isConstant(g);
+  });
 
   return count;
 } // BddImpl::countNodes
@@ -809,227 +1896,208 @@ BddImpl::index(const BDD f) const
 } // BddImpl::index
 
 
-//      Function : BddImpl::getAndCache
-//      Abstract : Retrieves an entry from the AND cache if it is there.
+//      Function : BddImpl::getCache
+//      Abstract : Retrieves the result of op(f,g,h) from the computed
+//      cache if it is there. Unused operands are the null node.
 BDD
-BddImpl::getAndCache(BDD f, BDD g)
+BddImpl::getCache(CacheOp op, BDD f, BDD g, BDD h)
 {
-  BDD rtn = _nullNode;
-  auto hash = hash2(f, g) & _compCacheMask;
-  CacheData2 &c = _andTbl[hash];
-  if (c._f == f && c._g == g) {
-    rtn = c._r;
-  } // if
+  ++_compLookups;
+  CacheSet &set = getCacheSet(op, f, g, h);
+  if (BDD rtn = findCacheEntry(set, op, f, g, h);
+      rtn) {
+    _cacheStats.incCompHit(op);
+    return rtn;
+  } // if hit
 
-  return rtn;
-} // BddImpl::getAndCache
+  _cacheStats.incCompMiss(op);
+  ++_compMisses;
+  return _nullNode;
+} // BddImpl::getCache
 
 
-//      Function : BddImpl::insertAndCache
-//      Abstract : Inserts a result into the AND cache.
+//      Function : BddImpl::insertCache
+//      Abstract : Inserts r into the computed cache as the result of
+//      op(f,g,h).
 void
-BddImpl::insertAndCache(BDD f, BDD g, BDD r)
+BddImpl::insertCache(CacheOp op,
+                     BDD f,
+                     BDD g,
+                     BDD h,
+                     BDD r,
+                     size_t cost)
 {
   if (r) {
-    auto hash = hash2(f, g) & _compCacheMask;
-    CacheData2 &c = _andTbl[hash];
-    c._f = f;
-    c._g = g;
-    c._r = r;
-  } // if
-} // BddImpl::insertAndCache
-
-
-//      Function : BddImpl::getXorCache
-//      Abstract : Retrieves an entry from the XOR cache if it is there.
-BDD
-BddImpl::getXorCache(BDD f, BDD g)
-{
-  BDD rtn = _nullNode;
-  auto hash = hash2(f, g) & _compCacheMask;
-  CacheData2 &c = _xorTbl[hash];
-  if (c._f == f && c._g == g) {
-    rtn = c._r;
-  } // if
-
-  return rtn;
-} // BddImpl::getXorCache
+    if (_compLookups >= cacheSize()) {
+      _cacheReviewDue = true;
+    } // if due for review
+    CacheSet &set = getCacheSet(op, f, g, h);
+    if (CacheOp evicted = putCacheEntry(set, op, f, g, h, r, cost);
+        evicted != CACHE_NONE) {
+      _cacheStats.incCompEvict(evicted);
+      ++_compEvicts;
+    } // if
+  } // if r
+} // BddImpl::insertCache
 
 
-//      Function : BddImpl::insertXorCache
-//      Abstract : Inserts a result into the XOR cache.
+//      Function : BddImpl::tuneCache
+//      Abstract : Review the size of the computed cache after a
+//      garbage collection. The cache shrinks when the collection
+//      frees most of the nodes and may grow otherwise.
 void
-BddImpl::insertXorCache(BDD f, BDD g, BDD r)
+BddImpl::tuneCache(size_t nodesFreed)
 {
-  if (r) {
-    auto hash = hash2(f, g) & _compCacheMask;
-    CacheData2 &c = _xorTbl[hash];
-    c._f = f;
-    c._g = g;
-    c._r = r;
-  } // if
-} // BddImpl::insertXorCache
-
-
-//      Function : BddImpl::getRestrictCache
-//      Abstract : Retrieves an entry from the restrict cache if it is
-//      there.
-BDD
-BddImpl::getRestrictCache(BDD f, BDD g)
-{
-  BDD rtn = _nullNode;
-  auto hash = hash2(f, g) & _compCacheMask;
-  CacheData2 &c = _restrictTbl[hash];
-  if (c._f == f && c._g == g) {
-    rtn = c._r;
+  size_t numEntries = cacheSize();
+  if (nodesFreed > 3 * _nodesAllocd) {
+    size_t fitSz = MIN_CACHE_SZ;
+    while (fitSz < 2 * _nodesAllocd) {
+      fitSz *= 2;
+    } // while
+    if (fitSz < numEntries) {
+      resizeCache(fitSz);
+    } // if
+  } else if (_cacheReviewDue || _compLookups >= numEntries) {
+    growCache();
   } // if
-
-  return rtn;
-} // BddImpl::getRestrictCache
+} // BddImpl::tuneCache
 
 
-//      Function : BddImpl::insertRestrictCache
-//      Abstract : Inserts a result into the restrict cache.
+//      Function : BddImpl::growCache
+//      Abstract : Called from gc() at the end of an operation once
+//      there have been as many lookups as entries since the size was
+//      last reviewed. Doubles the cache if cacheShouldGrow() says so
+//      and restarts the counts.
 void
-BddImpl::insertRestrictCache(BDD f, BDD g, BDD r)
+BddImpl::growCache()
 {
-  if (r) {
-    auto hash = hash2(f, g) & _compCacheMask;
-    CacheData2 &c = _restrictTbl[hash];
-    c._f = f;
-    c._g = g;
-    c._r = r;
+  if (cacheShouldGrow()) {
+    resizeCache(2 * cacheSize());
   } // if
-} // BddImpl::insertRestrictCache
-
-
-//      Function : BddImpl::getIteCache
-//      Abstract : Looks in the computed cache to see if the
-//      ite(f,g,h) has been saved.
-BDD
-BddImpl::getIteCache(const BDD f,
-                     const BDD g,
-                     const BDD h)
+  _compLookups = 0;
+  _compEvicts = 0;
+  _compMissMark = _compMisses;
+  _cacheReviewDue = false;
+} // BddImpl::growCache
+
+
+//      Function : BddImpl::cacheShouldGrow
+//      Abstract : Returns true if the computed cache has seen enough
+//      reuse to be worth enlarging, is full enough that results are
+//      being evicted, and doubling it leaves at most two entries per
+//      live node and keeps it within _cacheRatio of node memory.
+bool
+BddImpl::cacheShouldGrow() const
 {
-  BDD rtn = _nullNode;
-  auto hash = hash3(f, g, h) & _compCacheMask;
-  CacheData3 &c = _iteTbl[hash];
-  if (c._f == f && c._g == g && c._h == h) {
-    rtn = c._r;
-  } // if
-
-  return rtn;
-} // BddImpl::getIteCache
-
-
-//      Function : BddImpl::insertIteCache
-//      Abstract : Inserts r into the computed table as being the
-//      result of ite(f,g,h).
+  size_t numEntries = cacheSize();
+  size_t misses = _compMisses - _compMissMark;
+  size_t hits = _compLookups - std::min(misses, _compLookups);
+  size_t newBytes = 2 * numEntries * sizeof(CacheEntry);
+  double nodeBytes =
+    static_cast<double>(_curNodes * (sizeof(BddNode) + sizeof(BddNodeAux)));
+
+  return (hits * 10 >= _compLookups
+          && _compEvicts * 2 >= numEntries
+          && numEntries <= _nodesAllocd
+          && static_cast<double>(newBytes) <= _cacheRatio * nodeBytes);
+} // BddImpl::cacheShouldGrow
+
+
+//      Function : BddImpl::resizeCache
+//      Abstract : Resize the computed cache to hold numEntries entries,
+//      rounded up to a power of 2, and rehash the current entries
+//      into it. When two entries compete for a way, the more costly
+//      one is kept.
 void
-BddImpl::insertIteCache(const BDD f,
-                        const BDD g,
-                        const BDD h,
-                        const BDD r)
+BddImpl::resizeCache(size_t numEntries)
 {
-  if (r) {
-    auto hash = hash3(f, g, h) & _compCacheMask;
-    CacheData3 &c = _iteTbl[hash];
-    c._f = f;
-    c._g = g;
-    c._h = h;
-    c._r = r;
-  } // if r
-} // BddImpl::insertIteCache
-
-
-//      Function : BddImpl::getAndExistsCache
-//      Abstract : Looks in the computed cache to see if the
-//      andExists(f,g,h) has been saved.
-BDD
-BddImpl::getAndExistsCache(const BDD f,
-                           const BDD g,
-                           const BDD h)
-{
-  BDD rtn = _nullNode;
-  auto hash = hash3(f, g, h) & _compCacheMask;
-  CacheData3 &c = _andExistTbl[hash];
-  if (c._f == f && c._g == g && c._h == h) {
-    rtn = c._r;
-  } // if
-
-  return rtn;
-} // BddImpl::getAndExistsCache
-
+  size_t numSets = 1;
+  while (numSets * CACHE_WAYS < numEntries) {
+    numSets *= 2;
+  } // while
 
-//      Function : BddImpl::insertAndExistsCache
-//      Abstract : Inserts r into the computed table as being the
-//      result of ite(f,g,h).
-void
-BddImpl::insertAndExistsCache(const BDD f,
-                              const BDD g,
-                              const BDD h,
-                              const BDD r)
+  // The new table is allocated by getCacheSet() when the first entry
+  // is moved or on the next lookup.
+  ComputedTbl oldTbl;
+  std::swap(oldTbl, _compTbl);
+  _compCacheSz = numSets;
+  _compCacheMask = numSets - 1;
+
+  for (const auto &oldSet : oldTbl) {
+    for (const auto &oldEntry : oldSet._way) {
+      if (oldEntry._op != CACHE_NONE && cacheEntryValid(oldEntry)) {
+        CacheOp op = static_cast<CacheOp>(oldEntry._op);
+        CacheSet &set = getCacheSet(op, oldEntry._f, oldEntry._g, oldEntry._h);
+        CacheEntry *victim = &set._way[0];
+        for (auto &entry : set._way) {
+          if (entry._cost < victim->_cost || entry._op == CACHE_NONE) {
+            victim = &entry;
+          } // if
+        } // for each way
+        if (victim->_op == CACHE_NONE || victim->_cost < oldEntry._cost) {
+          *victim = oldEntry;
+        } // if
+      } // if
+    } // for each way
+  } // for each set
+
+  _cacheStats.incCompResize();
+  _compLookups = 0;
+  _compEvicts = 0;
+  _compMissMark = _compMisses;
+  _cacheReviewDue = false;
+} // BddImpl::resizeCache
+
+
+//      Function : BddImpl::getCacheSet
+//      Abstract : Returns the set of the computed cache that holds
+//      op(f,g,h). The cache is allocated here on
+//      first use so that managers which do little work stay small.
+BddImpl::CacheSet &
+BddImpl::getCacheSet(CacheOp op, BDD f, BDD g, BDD h)
 {
-  if (r) {
-    auto hash = hash3(f, g, h) & _compCacheMask;
-    CacheData3 &c = _andExistTbl[hash];
-    c._f = f;
-    c._g = g;
-    c._h = h;
-    c._r = r;
-  } // if r
-} // BddImpl::insertAndExistsCache
-
-
-//      Function : BddImpl::cleanCaches
-//      Abstract : Remove cache entries with unreferenced nodes. Used
-//      after garbage collection and reordering.
-void
-BddImpl::cleanCaches(const bool force)
+  if (_compTbl.empty()) {
+    _compTbl.resize(_compCacheSz);
+  } // if first use
+  return _compTbl[cacheSetIndex(op, f, g, h)];
+} // BddImpl::getCacheSet
+
+
+//      Function : BddImpl::cacheEntryValid
+//      Abstract : Returns true if no node of a computed cache entry
+//      has been freed since the entry was made. Nodes are only freed
+//      or moved by gc(), reorder(), reset() and compact(), which all
+//      advance _epoch, so entries made in the current epoch are valid.
+//      Otherwise, each node must still be allocated and must be at
+//      least as old as the entry. A node moved by compact() is dated
+//      as new, so entries naming its old or new id are rejected. Node
+//      ages are kept modulo BDD_GEN_SZ so older entries are rejected.
+//      During a parallel operation a node may be made by another
+//      worker while this runs, so its index is read before its age.
+//      Reordering preserves functions but not the result of
+//      restrict() which depends on the variable order.
+bool
+BddImpl::cacheEntryValid(const CacheEntry &entry) const
 {
-  cleanCache(_andTbl, force);
-  cleanCache(_xorTbl, force);
-  cleanCache(_restrictTbl, force);
-  cleanCache(_iteTbl, force);
-  cleanCache(_andExistTbl, force);
-} // BddImpl::cleanCaches
-
+  uint32_t age = _epoch - entry._epoch;
+  if (age == 0) {
+    return true;
+  } else if (age >= BDD_GEN_SZ ||
+             (entry._op == CACHE_RESTRICT &&
+              _epoch - _orderEpoch < age)) {
+    return false;
+  } // if
 
-//      Function : BddImpl::cleanCache
-//      Abstract : Clean a computed cache.
-void
-BddImpl::cleanCache(ComputedTbl2 &table, bool force)
-{
-  for (auto &data : table) {
-    bool umF = nodeUnmarked(data._f, 0);
-    bool umG = nodeUnmarked(data._g, 0);
-    bool umR = nodeUnmarked(data._r, 0);
-    if (force || umF || umG || umR) {
-      data._f = _nullNode;
-      data._g = _nullNode;
-      data._r = _nullNode;
+  for (BDD f : {entry._f, entry._g, entry._h, entry._r}) {
+    if (f > 3 &&
+        (getNode(f).loadIndex() == 0 ||
+         ((_epoch - getAux(f).getGen()) & BDD_GEN_MASK) < age)) {
+      return false;
     } // if
-  } // for
-} // BddImpl::cleanCache
+  } // for each node
 
+  return true;
+} // BddImpl::cacheEntryValid
 
-//      Function : BddImpl::cleanCache
-//      Abstract : Clean a computed cache.
-void
-BddImpl::cleanCache(ComputedTbl3 &table, bool force)
-{
-  for (auto &data : table) {
-    bool umF = nodeUnmarked(data._f, 0);
-    bool umG = nodeUnmarked(data._g, 0);
-    bool umH = nodeUnmarked(data._h, 0);
-    bool umR = nodeUnmarked(data._r, 0);
-    if (force || umF || umG || umH || umR) {
-      data._f = _nullNode;
-      data._g = _nullNode;
-      data._h = _nullNode;
-      data._r = _nullNode;
-    } // if
-  } // for
-} // BddImpl::cleanCache
 
 } // namespace abide
@@ -4,9 +4,14 @@
 //
 
 #include <BddImpl.h>
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <iostream>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 namespace abide {
 
@@ -20,25 +25,33 @@ namespace abide {
 //      Abstract : Possibly perform a garbage collection. Return the number
 //      collected nodes. Will not run if lock is set. Otherwise, runs
 //      if force is set or the number of allocated nodes id greater
-//      than the current trigger.
+//      than the current trigger. The BddMgr wrappers call it after
+//      every operation, so it is also where the computed cache is
+//      resized, never in the middle of an operation. That is done even
+//      if the lock is set, since resizing frees no node.
 size_t
 BddImpl::gc(bool force, bool verbose)
 {
   size_t nodesFreed = 0;
-  static int numGCs = 0;
 
   if (_gcLock > 0) {
+    if (_cacheReviewDue) {
+      growCache();
+    } // if
     return 0;
   } // if
 
   if (force || _nodesAllocd > _gcTrigger) {
-    ++numGCs;
+    auto start = std::chrono::steady_clock::now();
+    ++_numGCs;
     markReferencedNodes();
-    cleanCaches(false);
 
     for (auto &tbl : _uniqTbls) {
       BDDVec nodes;
       tbl.clear(*this, nodes);
+      auto dead = std::partition(nodes.begin(), nodes.end(),
+                                 [this](BDD f) { return nodeMarked(f, 0); });
+      tbl.shrink(dead - nodes.begin());
       for (auto f : nodes) {
         if (nodeMarked(f, 0)) {
           unmarkNode(f, 0);
@@ -56,17 +69,271 @@ BddImpl::gc(bool force, bool verbose)
     assert(_nodesAllocd + _nodesFree == _curNodes);
     // assert(_nodesFree == countFreeNodes());
 
+    // Cache entries made before now are checked when found.
+    ++_epoch;
+
+    if (_autoCompact && _nodesFree > _nodesAllocd + BDD_VEC_SZ) {
+      compact(verbose);
+    } // if mostly free
+
+    std::chrono::duration<double, std::milli> pause =
+      std::chrono::steady_clock::now() - start;
+    _cacheStats.addGCPause(pause.count());
     if (verbose) {
-      std::cout << "Garbage Collection #" << numGCs << ": "
+      std::cout << "Garbage Collection #" << _numGCs << ": "
                 << _nodesAllocd << " : " << nodesFreed
+                << " (" << pause.count() << " ms)"
                 << std::endl;
     } // if
   } // if unlocked for gc
 
+  tuneCache(nodesFreed);
+
   return nodesFreed;
 } // BddImpl::gc
 
 
+//      Function : BddImpl::reset
+//      Abstract : Return the manager to the empty state by freeing
+//      every node other than the constants. Node banks, unique tables
+//      and the computed cache keep their memory so that a pooled
+//      manager can be reused without going back to the system
+//      allocator. Variables keep their current order. Fails and
+//      returns false if gc is locked or a node is still referenced.
+bool
+BddImpl::reset()
+{
+  if (_gcLock > 0) {
+    return false;
+  } // if
+
+  for (const auto &tbl : _uniqTbls) {
+    bool referenced = false;
+    forEachNode(tbl, [this, &referenced](BDD f) {
+      referenced = referenced || numRefs(f) > 0;
+    });
+    if (referenced) {
+      return false;
+    } // if
+  } // for each tbl
+
+  for (auto &tbl : _uniqTbls) {
+    BDDVec nodes;
+    forEachNode(tbl, [&nodes](BDD f) { nodes.push_back(f); });
+    tbl.reset();
+    for (auto f : nodes) {
+      clearNode(f);
+    } // for each node
+  } // for each tbl
+  _nodesAllocd = 2;
+  rebuildFreeList();
+  _gcTrigger = std::min(1UL<<10, _maxNodes<<6);
+
+  // Every cache entry refers to a freed node, so a new epoch makes
+  // them all invalid without touching the table.
+  ++_epoch;
+  _compLookups = 0;
+  _compEvicts = 0;
+  _compMissMark = _compMisses;
+  _cacheReviewDue = false;
+
+  assert(_nodesAllocd + _nodesFree == _curNodes);
+  return true;
+} // BddImpl::reset
+
+
+//      Function : BddImpl::compact
+//      Abstract : Move nodes out of the upper banks so that those
+//      banks can be released. Nodes with external references may be
+//      held in Bdds which cannot be updated, so they stay where they
+//      are and their banks are kept. The lowest of the other banks
+//      are kept until they can hold every node. The nodes of the
+//      remaining banks are copied into free slots of kept banks and
+//      their old slots hold the new ids until every child and unique
+//      table is rewritten. The computed cache is emptied since its
+//      entries may refer to released banks. Returns the number of
+//      node slots released.
+size_t
+BddImpl::compact(bool verbose)
+{
+  if (_gcLock > 0) {
+    return 0;
+  } // if
+
+  const size_t numBanks = _banks.size();
+  auto bankUsed = [this](size_t bdx) { return _banks[bdx] != nullptr; };
+  auto bankOf = [](BDD f) -> size_t { return f >> (BDD_VEC_LG_SZ + 1); };
+
+  std::vector<bool> keep(numBanks, false);
+  keep[0] = true;
+  for (const auto &tbl : _uniqTbls) {
+    forEachNode(tbl, [&](BDD f) {
+      if (numRefs(f) > 0) {
+        keep[bankOf(f)] = true;
+      } // if pinned
+    });
+  } // for each tbl
+  size_t keptSlots = 0;
+  for (size_t bdx = 0; bdx < numBanks; ++bdx) {
+    if (bankUsed(bdx) &&
+        (keep[bdx] || keptSlots < _nodesAllocd)) {
+      keep[bdx] = true;
+      keptSlots += BDD_VEC_SZ;
+    } // if
+  } // for each bank
+  if (_flat) {
+    // A flat array can only give up its end.
+    size_t numKept = numBanks;
+    while (numKept > 1 && !keep[numKept - 1]) {
+      --numKept;
+    } // while
+    std::fill(keep.begin(), keep.begin() + numKept, true);
+    keptSlots = numKept * BDD_VEC_SZ;
+  } // if
+  if (keptSlots == _curNodes) {
+    return 0;
+  } // if nothing to release
+
+  // Free slots of the kept banks in address order.
+  BDDVec freeSlots;
+  freeSlots.reserve(keptSlots - std::min(keptSlots, _nodesAllocd));
+  for (size_t bdx = numBanks; bdx > 0; --bdx) {
+    if (keep[bdx - 1]) {
+      for (size_t idx = BDD_VEC_SZ; idx > 0; --idx) {
+        BDD f = (((bdx - 1) << BDD_VEC_LG_SZ) + idx - 1) << 1;
+        if (f != _nullNode && getNode(f).getIndex() == 0) {
+          freeSlots.push_back(f);
+        } // if free
+      } // for each slot
+    } // if kept
+  } // for each bank
+
+  // Copy the nodes of the released banks and leave their new ids in
+  // the old hi fields. The copies belong to a new epoch.
+  ++_epoch;
+  size_t nodesMoved = 0;
+  for (const auto &tbl : _uniqTbls) {
+    forEachNode(tbl, [&](BDD f) {
+      if (!keep[bankOf(f)]) {
+        BDD nu = freeSlots.back();
+        freeSlots.pop_back();
+        BddNode &from = getNode(f);
+        BddNode &to = getNode(nu);
+        clearNode(nu);
+        to.setIndex(from.getIndex());
+        to.setHi(from.getHi());
+        to.setLo(from.getLo());
+        getAux(nu).setGen(_epoch & BDD_GEN_MASK);
+        from.setHi(nu);
+        ++nodesMoved;
+      } // if moving
+    });
+  } // for each tbl
+
+  auto forward = [&](BDD f) {
+    return keep[bankOf(f)] ? f : getNode(abs(f)).getHi() | (f & 0x01);
+  };
+  for (auto &tbl : _uniqTbls) {
+    BDDVec nodes;
+    tbl.clear(*this, nodes);
+    for (auto f : nodes) {
+      f = forward(f);
+      BddNode &n = getNode(f);
+      n.setHi(forward(n.getHi()));
+      n.setLo(forward(n.getLo()));
+      tbl.putHash(*this, f);
+    } // for each node
+  } // for each tbl
+
+  ComputedTbl().swap(_compTbl);
+  _compLookups = 0;
+  _compEvicts = 0;
+  _compMissMark = _compMisses;
+  _cacheReviewDue = false;
+
+  size_t released = _curNodes - keptSlots;
+  if (_flat) {
+    if (_nodeArena.valid()) {
+      _nodeArena.release(keptSlots * _nodeSz,
+                         (_curNodes - keptSlots) * _nodeSz);
+      if (_splitNodes) {
+        _auxArena.release(keptSlots, _curNodes - keptSlots);
+      } // if
+      if (_chainUniq) {
+        _linkArena.release(keptSlots, _curNodes - keptSlots);
+      } // if
+    } else {
+      _nodes = static_cast<char *>(realloc(_nodes, keptSlots * _nodeSz));
+      if (_splitNodes) {
+        _auxNodes =
+          static_cast<BddNodeAux *>(realloc(_auxNodes,
+                                            keptSlots * sizeof(BddNodeAux)));
+      } // if
+      if (_chainUniq) {
+        _links = static_cast<BDD *>(realloc(_links, keptSlots * sizeof(BDD)));
+      } // if
+    } // if
+    setFlatBanks(keptSlots);
+  } else {
+    for (size_t bdx = 0; bdx < numBanks; ++bdx) {
+      if (!keep[bdx] && _banks[bdx]) {
+        if (_nodeArena.valid()) {
+          _nodeArena.release((bdx << BDD_VEC_LG_SZ) * _nodeSz,
+                             BDD_VEC_SZ * _nodeSz);
+          if (_splitNodes) {
+            _auxArena.release(bdx << BDD_VEC_LG_SZ, BDD_VEC_SZ);
+          } // if
+          if (_chainUniq) {
+            _linkArena.release(bdx << BDD_VEC_LG_SZ, BDD_VEC_SZ);
+          } // if
+        } else {
+          free(_banks[bdx]);
+          if (_splitNodes) {
+            delete [] _auxBanks[bdx];
+          } // if
+          if (_chainUniq) {
+            delete [] _linkBanks[bdx];
+          } // if
+        } // if
+        _banks[bdx] = nullptr;
+        if (_splitNodes) {
+          _auxBanks[bdx] = nullptr;
+        } // if
+        if (_chainUniq) {
+          _linkBanks[bdx] = nullptr;
+        } // if
+      } // if released
+    } // for each bank
+    while (!_banks.back()) {
+      _banks.pop_back();
+      if (_splitNodes) {
+        _auxBanks.pop_back();
+      } // if
+      if (_chainUniq) {
+        _linkBanks.pop_back();
+      } // if
+    } // while
+#ifdef __GLIBC__
+    // Once a bank has been freed, glibc raises its mmap threshold and
+    // later banks come from the heap. Trimming returns their pages.
+    if (!_nodeArena.valid()) {
+      malloc_trim(0);
+    } // if
+#endif
+  } // if
+  _curNodes = keptSlots;
+  rebuildFreeList();
+
+  if (verbose) {
+    std::cout << "Compaction: moved " << nodesMoved << " nodes, released "
+              << released << " slots" << std::endl;
+  } // if
+  assert(_nodesAllocd + _nodesFree == _curNodes);
+
+  return released;
+} // BddImpl::compact
+
+
 //      Function : BddImpl::reorder
 //      Abstract : Reorder variables using Rick Rudell's sifting
 //      algorithm.
@@ -77,6 +344,12 @@ BddImpl::reorder(bool verbose)
   lockGC();
   _reordering = true;
 
+  // Exchanging levels keeps each node id bound to the same function,
+  // so the computed cache stays valid except for entries with nodes
+  // freed by promote(). Starting a new epoch lets cacheEntryValid()
+  // reject those even if the ids are reused during reordering.
+  ++_epoch;
+
   bddCntMap refs;
   auto startSize = _nodesAllocd;
 
@@ -105,7 +378,7 @@ BddImpl::reorder(bool verbose)
 
   _reordering = false;
   unlockGC();
-  cleanCaches(true);
+  _orderEpoch = _epoch;
 
   if (verbose) {
     int saved = startSize - int(_nodesAllocd);
@@ -125,10 +398,33 @@ BddImpl::reorder(bool verbose)
 //////////////////////////////////////////////////////////////////////////////
 
 
+//      Function : BddImpl::reserveArena
+//      Abstract : Reserve address space for every possible node so
+//      that banks or the flat array are placed rather than allocated.
+//      If any part cannot be reserved, node memory comes from the heap.
+void
+BddImpl::reserveArena(bool huge)
+{
+  bool ok = _nodeArena.reserve(BDD_MAX_NODES * _nodeSz, huge);
+  if (_splitNodes) {
+    ok = ok && _auxArena.reserve(BDD_MAX_NODES, huge);
+  } // if
+  if (_chainUniq) {
+    ok = ok && _linkArena.reserve(BDD_MAX_NODES, huge);
+  } // if
+  if (!ok) {
+    _nodeArena.unreserve();
+    _auxArena.unreserve();
+    _linkArena.unreserve();
+  } // if
+} // BddImpl::reserveArena
+
+
 //      Function : BddImpl::allocateNode
-//      Abstract : Allocate a BDD node if possible.
+//      Abstract : Allocate a BDD node if possible. near is a node the
+//      new one will refer to. See popFree().
 BDD
-BddImpl::allocateNode()
+BddImpl::allocateNode(const BDD near)
 {
   BDD rtn = _nullNode;
 
@@ -144,14 +440,13 @@ BddImpl::allocateNode()
   } // if no node free
 
   if (_nodesFree) {
-    rtn = _freeList;
-    BddNode &node(getNode(_freeList));
-    _freeList = node.getNext();
-    node.clear();
+    rtn = popFree(near);
+    clearNode(rtn);
+    getAux(rtn).setGen(_epoch & BDD_GEN_MASK);
     ++_nodesAllocd;
     --_nodesFree;
     _maxAllocd = std::max(_maxAllocd, _nodesAllocd);
-    assert(rtn/2 < _curNodes);
+    assert(rtn/2 < (_banks.size() << BDD_VEC_LG_SZ));
   } // if nodes free
 
   assert(_nodesAllocd + _nodesFree == _curNodes);
@@ -167,65 +462,232 @@ BddImpl::allocateNode()
 void
 BddImpl::allocateMoreNodes()
 {
-#ifdef BANKEDMEM
-  if (_curNodes < _maxNodes) {
-    size_t bdx = _banks.size();
-    BddBank nuBank = new BddNode[BDD_VEC_SZ];
-    if (nuBank) {
-      _banks.push_back(nuBank);
-      _freeList = bdx << (BDD_VEC_LG_SZ + 1);
-
-      for (size_t idx = 1; idx < BDD_VEC_SZ; ++idx) {
-        BddNode &node(nuBank[idx-1]);
-        node.setNext(_freeList + 2*idx);
-      } // for
+  if (_curNodes >= _maxNodes) {
+    return;
+  } // if at max
 
-      nuBank[BDD_VEC_SZ-1].setNext(0);
-
-      _nodesFree = BDD_VEC_SZ;
-      _curNodes += BDD_VEC_SZ;
-      // assert(_nodesFree == countFreeNodes() || _nodesAllocd == 0);
-    } // if allocated new bank of nodes
-  } // if less than max
-#else
-  if (_curNodes < _maxNodes) {
+  if (_flat) {
     auto tgtSize = 2 * _curNodes;
     tgtSize = std::max(tgtSize, 1UL<<16);
-    BddNode *nuNodes =
-      static_cast<BddNode *>(realloc(_nodes, tgtSize * sizeof(BddNode)));
+    char *nuNodes = nullptr;
+    if (_nodeArena.valid()) {
+      // The array is already in place and only needs to be touched.
+      tgtSize = std::min(tgtSize, _nodeArena.size() / _nodeSz);
+      if (tgtSize > _curNodes) {
+        nuNodes = _nodes = _nodeArena.at(0);
+        if (_splitNodes) {
+          _auxNodes = _auxArena.at(0);
+        } // if
+        if (_chainUniq) {
+          _links = _linkArena.at(0);
+        } // if
+      } // if room
+    } else {
+      nuNodes = static_cast<char *>(realloc(_nodes, tgtSize * _nodeSz));
+      if (nuNodes) {
+        _nodes = nuNodes;
+      } // if
+      if (nuNodes && _splitNodes) {
+        BddNodeAux *nuAux =
+          static_cast<BddNodeAux *>(realloc(_auxNodes,
+                                            tgtSize * sizeof(BddNodeAux)));
+        if (nuAux) {
+          _auxNodes = nuAux;
+        } else {
+          nuNodes = nullptr;
+        } // if
+      } // if
+      if (nuNodes && _chainUniq) {
+        BDD *nuLinks =
+          static_cast<BDD *>(realloc(_links, tgtSize * sizeof(BDD)));
+        if (nuLinks) {
+          _links = nuLinks;
+        } else {
+          nuNodes = nullptr;
+        } // if
+      } // if
+    } // if arena
     if (nuNodes) {
-      _nodes = nuNodes;
-      _freeList = _curNodes<<1;
-      BddNode *node = _nodes + _curNodes;
-      for (auto idx = _curNodes+1; idx < tgtSize; ++idx) {
-        node->clear();
-        node->setNext(idx<<1);
-        node = _nodes + idx;
+      setFlatBanks(tgtSize);
+      // The null node, id 0, is never on the free list.
+      for (auto idx = tgtSize; idx > _curNodes; --idx) {
+        clearNode((idx-1)<<1);
+        if (idx > 1) {
+          pushFree((idx-1)<<1);
+          ++_nodesFree;
+        } // if
       } // for
-      node->clear();
-      _nodesFree = tgtSize - _curNodes;
       _curNodes = tgtSize;
     } // if
-  } // if less than max
-#endif
+  } else {
+    // Reuse the slot of a bank released by compact() if there is one.
+    size_t bdx = std::find(_banks.begin(), _banks.end(), nullptr) - _banks.begin();
+    BddBank nuBank = (_nodeArena.valid()
+                      ? _nodeArena.at((bdx << BDD_VEC_LG_SZ) * _nodeSz)
+                      : static_cast<char *>(calloc(BDD_VEC_SZ, _nodeSz)));
+    if (nuBank) {
+      if (bdx == _banks.size()) {
+        _banks.push_back(nullptr);
+        if (_splitNodes) {
+          _auxBanks.push_back(nullptr);
+        } // if
+        if (_chainUniq) {
+          _linkBanks.push_back(nullptr);
+        } // if
+      } // if no slot to reuse
+      _banks[bdx] = nuBank;
+      if (_splitNodes) {
+        _auxBanks[bdx] = (_nodeArena.valid()
+                           ? _auxArena.at(bdx << BDD_VEC_LG_SZ)
+                           : new BddNodeAux[BDD_VEC_SZ]());
+      } // if
+      if (_chainUniq) {
+        _linkBanks[bdx] = (_nodeArena.valid()
+                           ? _linkArena.at(bdx << BDD_VEC_LG_SZ)
+                           : new BDD[BDD_VEC_SZ]());
+      } // if
+      // The null node, id 0, is never on the free list.
+      const BDD first = bdx << (BDD_VEC_LG_SZ + 1);
+      for (size_t idx = BDD_VEC_SZ; idx > 0; --idx) {
+        if (BDD f = first + 2*(idx-1);
+            f != _nullNode) {
+          pushFree(f);
+          ++_nodesFree;
+        } // if
+      } // for
+
+      _curNodes += BDD_VEC_SZ;
+      // assert(_nodesFree == countFreeNodes() || _nodesAllocd == 0);
+    } // if allocated new bank of nodes
+  } // if
 } // BddImpl::allocateMoreNodes
 
 
+//      Function : BddImpl::setFlatBanks
+//      Abstract : Point _banks at the pieces of the flat array so that
+//      nodes are found the same way in either layout. Called whenever
+//      the array is moved or resized to hold numNodes nodes.
+void
+BddImpl::setFlatBanks(const size_t numNodes)
+{
+  const size_t numBanks = numNodes >> BDD_VEC_LG_SZ;
+  _banks.resize(numBanks);
+  if (_splitNodes) {
+    _auxBanks.resize(numBanks);
+  } // if
+  if (_chainUniq) {
+    _linkBanks.resize(numBanks);
+  } // if
+  for (size_t bdx = 0; bdx < numBanks; ++bdx) {
+    _banks[bdx] = _nodes + (bdx << BDD_VEC_LG_SZ) * _nodeSz;
+    if (_splitNodes) {
+      _auxBanks[bdx] = _auxNodes + (bdx << BDD_VEC_LG_SZ);
+    } // if
+    if (_chainUniq) {
+      _linkBanks[bdx] = _links + (bdx << BDD_VEC_LG_SZ);
+    } // if
+  } // for each bank
+} // BddImpl::setFlatBanks
+
+
+//      Function : BddImpl::rebuildFreeList
+//      Abstract : Thread every free node, those with index 0 other
+//      than the null node, onto the free list in address order.
+void
+BddImpl::rebuildFreeList()
+{
+  _freeList = 0;
+  _regionFree.clear();
+  _allocRegion = 0;
+  _nodesFree = 0;
+  const size_t numSlots = _banks.size() * BDD_VEC_SZ;
+  for (size_t idx = numSlots; idx > 1; --idx) {
+    if (!_banks[(idx - 1) >> BDD_VEC_LG_SZ]) {
+      idx -= BDD_VEC_SZ - 1;
+      continue;
+    } // if released bank
+    BDD f = (idx - 1) << 1;
+    BddNode &n = getNode(f);
+    if (n.getIndex() == 0) {
+      pushFree(f);
+      ++_nodesFree;
+    } // if free
+  } // for each node
+} // BddImpl::rebuildFreeList
+
+
+//      Function : BddImpl::pushFree
+//      Abstract : Put a node, already cleared, on the free list of
+//      its region or on the single free list.
+void
+BddImpl::pushFree(const BDD f)
+{
+  if (_localAlloc) {
+    size_t rdx = f >> (LOCAL_REGION_LG_SZ + 1);
+    if (rdx >= _regionFree.size()) {
+      _regionFree.resize(rdx + 1, 0);
+    } // if new region
+    getNode(f).setHi(_regionFree[rdx]);
+    _regionFree[rdx] = f;
+  } else {
+    getNode(f).setHi(_freeList);
+    _freeList = f;
+  } // if
+} // BddImpl::pushFree
+
+
+//      Function : BddImpl::popFree
+//      Abstract : Take a node off a free list. There must be one. With
+//      local allocation it comes from the region of near if that has room
+//      so that a node is placed close to its children. Otherwise, it
+//      comes from the region allocation last continued in or the next
+//      one with room.
+BDD
+BddImpl::popFree(const BDD near)
+{
+  if (!_localAlloc) {
+    BDD rtn = _freeList;
+    _freeList = getNode(rtn).getHi();
+    return rtn;
+  } // if
+
+  size_t rdx = near >> (LOCAL_REGION_LG_SZ + 1);
+  if (rdx >= _regionFree.size() || !_regionFree[rdx]) {
+    rdx = _allocRegion;
+    while (!_regionFree[rdx]) {
+      rdx = rdx + 1 < _regionFree.size() ? rdx + 1 : 0;
+    } // while
+    _allocRegion = rdx;
+  } // if near is full
+  BDD rtn = _regionFree[rdx];
+  _regionFree[rdx] = getNode(rtn).getHi();
+  return rtn;
+} // BddImpl::popFree
+
+
 //      Function : BddImpl::freeNode
 //      Abstract : Put a node on the free list
 void
 BddImpl::freeNode(const BDD f)
 {
-  BddNode &node = getNode(f);
-  node.clear();
-  node.setNext(_freeList);
-  _freeList = f;
+  clearNode(f);
+  pushFree(f);
   --_nodesAllocd;
   ++_nodesFree;
   // assert(_nodesFree == countFreeNodes());
 } // BddImpl::freeNode
 
 
+//      Function : BddImpl::clearNode
+//      Abstract : Clear all fields of a node.
+void
+BddImpl::clearNode(const BDD f)
+{
+  getNode(f).clear();
+  getAux(f).clear();
+} // BddImpl::clearNode
+
+
 //      Function : BddImpl::findOrAddUniqTbl
 //      Abstract : Abstract : Find a node in or add a node to the unique table.
 BDD
@@ -246,14 +708,30 @@ BddImpl::findOrAddUniqTbl(const BddIndex index,
     lo = invert(lo);
   } // if need inverted node.
 
+  auto start = _cacheStats.startTimer();
   UniqTbl &tbl = _uniqTbls[index];
   rtn = tbl.findOrAdd(*this, index, hi, lo);
   rtn = inv ? invert(rtn) : rtn ;
+  _cacheStats.addUniqLatency(start);
 
   return rtn;
 } // BddImpl::findOrAddUniqTbl
 
 
+//      Function : BddImpl::prefetchUniqTbl
+//      Abstract : Start loading what findOrAddUniqTbl() will first
+//      read for the same arguments.
+void
+BddImpl::prefetchUniqTbl(const BddIndex index, BDD hi, BDD lo)
+{
+  if (isNegPhase(hi)) {
+    hi = invert(hi);
+    lo = invert(lo);
+  } // if need inverted node.
+  _uniqTbls[index].prefetch(hi, lo);
+} // BddImpl::prefetchUniqTbl
+
+
 //      Function : BddImpl::markReferencedNodes
 //      Abstract : Mark all nodes that have a reference either
 //      directly or indirectly.
@@ -261,48 +739,47 @@ void
 BddImpl::markReferencedNodes()
 {
   for (const auto &tbl : _uniqTbls) {
-    for (size_t hdx = 0; hdx < tbl.size(); ++hdx) {
-      BDD f = tbl.getHash(hdx);
-      while (f) {
-        if (numRefs(f) > 0) {
-          markNodes(f, 0);
-        } // if refs
-        f = getNext(f);
-      } // while nodes ro process
-    } // for each hash
+    forEachNode(tbl, [this](BDD f) {
+      if (numRefs(f) > 0) {
+        markNodes(f, 0);
+      } // if refs
+    });
   } // for each tbl
 } // BddImpl::markReferencedNodes
 
 
 //      Function : BddImpl::markNodes
-//      Abstract : Recursively mark nodes rooted at this node.
+//      Abstract : Mark nodes rooted at this node.
 void
 BddImpl::markNodes(const BDD f, uint32_t m) const
 {
-  if (f > 3) {
-    BddNode &node = getNode(f);
-    if (!node.marked(m)) {
-      node.setMark(m);
-      markNodes(node.getHi(), m);
-      markNodes(node.getLo(), m);
-    } // if unmarked
-  } // if f is not the null, 1- or 0-node.
+  walkNodes(f, [this, m](BDD g) {
+    if (g <= 3) {
+      return false;
+    } // if g is the null, 1- or 0-node.
+    BddNodeAux &aux = getAux(g);
+    if (aux.marked(m)) {
+      return false;
+    } // if visited
+    aux.setMark(m);
+    return true;
+  });
 } // BddImpl::markNodes
 
 
 //      Function : BddImpl::unmarkNodes
-//      Abstract : Recursively unmark nodes rooted at this node.
+//      Abstract : Unmark nodes rooted at this node.
 void
 BddImpl::unmarkNodes(const BDD f, uint32_t m) const
 {
-  BddNode &node = getNode(f);
-  if (node.marked(m)) {
-    node.clrMark(m);
-    if (f > 3) {
-      unmarkNodes(node.getHi(), m);
-      unmarkNodes(node.getLo(), m);
-    } // if f is not the null, 1- or 0-node.
-  } // if marked
+  walkNodes(f, [this, m](BDD g) {
+    BddNodeAux &aux = getAux(g);
+    if (!aux.marked(m)) {
+      return false;
+    } // if not marked
+    aux.clrMark(m);
+    return g > 3;
+  });
 } // BddImpl::unmarkNodes
 
 
@@ -458,8 +935,7 @@ BddImpl::demote(const BDDVec &nodes, const BddIndex idx)
       BDD f0 = node.getLo();
       if (getIndex(f0) > idx+1) {
         node.setIndex(idx+1);
-        size_t h = hash2(f1, f0) & tbl.getMask();
-        tbl.putHash(*this, f, h);
+        tbl.putHash(*this, f);
       } // if f0
     } // if f1
   } // for each node in level
@@ -501,10 +977,8 @@ BddImpl::swapCofactors(const BDDVec &nodes, const BddIndex idx)
 
       if (f11 != f01) {
         f1 = findOrAddUniqTbl(idx+1, f11, f01);
-#ifndef BANKEDMEM
-        // There may have been a realloc during findOrAddUniqTbl().
+        // A flat array may have been moved by findOrAddUniqTbl().
         node = getNodePtr(f);
-#endif
       } else {
         f1 = f11;
       } // if
@@ -513,10 +987,8 @@ BddImpl::swapCofactors(const BDDVec &nodes, const BddIndex idx)
 
       if (f10 != f00) {
         f0 = findOrAddUniqTbl(idx+1, f10, f00);
-#ifndef BANKEDMEM
-        // There may have been a realloc during findOrAddUniqTbl().
+        // A flat array may have been moved by findOrAddUniqTbl().
         node = getNodePtr(f);
-#endif
       } else {
         f0 = f00;
       } // if
@@ -556,16 +1028,12 @@ void
 BddImpl::saveXRefs(bddCntMap &refs)
 {
   for (const auto &tbl : _uniqTbls) {
-    for (size_t hdx = 0; hdx < tbl.size(); ++hdx) {
-      BDD f = tbl.getHash(hdx);
-      while (f) {
-        if (numRefs(f) > 0) {
-          refs[f] = numRefs(f);
-          setRefs(f, 0);
-        } // if refs
-        f = getNext(f);
-      } // while nodes ro process
-    } // for each hash
+    forEachNode(tbl, [this, &refs](BDD f) {
+      if (numRefs(f) > 0) {
+        refs[f] = numRefs(f);
+        setRefs(f, 0);
+      } // if refs
+    });
   } // for each tbl
 } // BddImpl::saveXRefs
 
@@ -592,62 +1060,53 @@ void
 BddImpl::restoreXRefs(bddCntMap &refs)
 {
   for (const auto &tbl : _uniqTbls) {
-    for (size_t hdx = 0; hdx < tbl.size(); ++hdx) {
-      BDD f = tbl.getHash(hdx);
-      while (f) {
-        setRefs(f, (refs.count(f) ? refs[f] : 0));
-        f = getNext(f);
-      } // while nodes ro process
-    } // for each hash
+    forEachNode(tbl, [this, &refs](BDD f) {
+      setRefs(f, (refs.count(f) ? refs[f] : 0));
+    });
   } // for each tbl
 } // restoreXRefs
 
 
 //      Function : BddImpl::calcTRefs
-//      Abstract : Recursively calculate trefs from this node.
+//      Abstract : Calculate trefs from this node.
 void
 BddImpl::calcTRefs(const BDD f)
 {
-  if (f > 3) {
-    BddNode &node = getNode(f);
-    if (node.numRefs() == 0) {
-      calcTRefs(node.getHi());
-      calcTRefs(node.getLo());
-    } // if first visit
-    node.incRef();
-  } // if non-constant
+  incTRefs(f);
 } // BddImpl::calcTRefs
 
 
 //      Function : BddImpl::decTRefs
-//      Abstract : Recursively decrement trefs from this node.
+//      Abstract : Decrement trefs from this node. The children of
+//      a node left without references are decremented in turn.
 void
 BddImpl::decTRefs(const BDD f)
 {
-  if (f > 3) {
-    BddNode &node = getNode(f);
-    node.decRef();
-    if (node.numRefs() == 0) {
-      decTRefs(node.getHi());
-      decTRefs(node.getLo());
-    } // if first visit
-  } // if non-constant
+  walkNodes(f, [this](BDD g) {
+    if (g <= 3) {
+      return false;
+    } // if constant
+    BddNodeAux &aux = getAux(g);
+    aux.decRef();
+    return aux.numRefs() == 0;
+  });
 } // BddImpl::decTRefs
 
 
 //      Function : BddImpl::incTRefs
-//      Abstract : Recursively increment trefs from this node.
+//      Abstract : Increment trefs from this node. The children of a
+//      node without references are incremented in turn.
 void
 BddImpl::incTRefs(const BDD f)
 {
-  if (f > 3) {
-    BddNode &node = getNode(f);
-    if (node.numRefs() == 0) {
-      incTRefs(node.getHi());
-      incTRefs(node.getLo());
-    } // if first visit
-    node.incRef();
-  } // if non-constant
+  walkNodes(f, [this](BDD g) {
+    if (g <= 3) {
+      return false;
+    } // if constant
+    BddNodeAux &aux = getAux(g);
+    aux.incRef();
+    return aux.numRefs() == 1;
+  });
 } // BddImpl::incTRefs
 
 
@@ -672,8 +1131,8 @@ BddImpl::checkMem() const
 void
 BddImpl::setRefs(const BDD f, const uint32_t n) const
 {
-  BddNode &node = getNode(f);
-  node.setRefs(n);
+  BddNodeAux &aux = getAux(f);
+  aux.setRefs(n);
 } // numRefs
 
 
@@ -683,7 +1142,7 @@ void
 BddImpl::incRef(BDD f) const
 {
   if (f && notConstant(f)) {
-    BddNode &n = getNode(f);
+    BddNodeAux &n = getAux(f);
     n.incRef();
   } // if
 } // BddImpl::incRef
@@ -694,7 +1153,7 @@ void
 BddImpl::decRef(BDD f) const
 {
   if (f && notConstant(f)) {
-    BddNode &n = getNode(f);
+    BddNodeAux &n = getAux(f);
     n.decRef();
   } //if
 } // decRef
@@ -705,7 +1164,7 @@ BddImpl::decRef(BDD f) const
 size_t
 BddImpl::numRefs(BDD f) const
 {
-  BddNode &n = getNode(f);
+  BddNodeAux &n = getAux(f);
   return n.numRefs();
 } // BddImpl::numRefs
 
@@ -716,11 +1175,16 @@ size_t
 BddImpl::countFreeNodes() const
 {
   size_t cnt = 0;
-  BDD b = _freeList;
-  while (b) {
-    ++cnt;
-    b = getNext(b);
-  } // while
+  auto countList = [this, &cnt](BDD b) {
+    while (b) {
+      ++cnt;
+      b = getNode(b).getHi();
+    } // while
+  };
+  countList(_freeList);
+  for (BDD b : _regionFree) {
+    countList(b);
+  } // for each region
   return cnt;
 } // BddImpl::countFreeNodes
 
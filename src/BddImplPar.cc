@@ -0,0 +1,385 @@
+//
+//      File     : BddImplPar.cc
+//      Abstract : Worker threads for parallel apply.
+//
+//      A large operation is split by spawning the second cofactor of
+//      each step near the top as a task which idle workers may steal,
+//      while the spawning worker goes on with the first. Below
+//      _spawnDepth each worker runs the sequential engine. Workers
+//      share the unique tables and computed cache. A node is added to
+//      a unique table with a compare and swap and comes from a batch
+//      the worker took from the free list under _allocLock. A cache set
+//      is locked only if it is free and is otherwise treated as a miss.
+//      A worker that finds a unique table too full or no node left
+//      asks the others to pause. Each stops at the next step it starts
+//      or while it waits for work, holding no node or table slot, and
+//      the asking worker grows the tables and node storage alone. If
+//      nothing could grow, it sets _parAbort and the operation winds
+//      down so that the caller's gc and retry take over. The cache
+//      counts of the workers are merged when the operation ends, and
+//      the computed cache is reviewed by the gc() that follows.
+//
+
+#include "BddImpl.h"
+
+namespace abide {
+
+//      Function : BddImpl::startPool
+//      Abstract : Make numThreads workers and start a thread for each
+//      but the first, which is run by the caller. Bank pointers are
+//      reserved in full so that adding a bank while the workers run
+//      never moves them.
+void
+BddImpl::startPool(const size_t numThreads)
+{
+  _banks.reserve(BDD_MAX_NODES >> BDD_VEC_LG_SZ);
+  if (_splitNodes) {
+    _auxBanks.reserve(BDD_MAX_NODES >> BDD_VEC_LG_SZ);
+  } // if
+  if (_chainUniq) {
+    _linkBanks.reserve(BDD_MAX_NODES >> BDD_VEC_LG_SZ);
+  } // if
+
+  _spawnDepth = PAR_SPAWN_EXTRA;
+  for (size_t n = 1; n < numThreads; n *= 2) {
+    ++_spawnDepth;
+  } // for
+
+  for (size_t id = 0; id < numThreads; ++id) {
+    _workers.push_back(std::make_unique<BddWorker>());
+    _workers.back()->_id = id;
+  } // for each worker
+  for (size_t id = 1; id < numThreads; ++id) {
+    _threads.emplace_back(&BddImpl::workerLoop, this, id);
+  } // for each thread
+} // BddImpl::startPool
+
+
+//      Function : BddImpl::stopPool
+//      Abstract : Stop and join the worker threads.
+void
+BddImpl::stopPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_poolLock);
+    _poolStop = true;
+  }
+  _poolWake.notify_all();
+  for (auto &thread : _threads) {
+    thread.join();
+  } // for each thread
+  _threads.clear();
+  _workers.clear();
+} // BddImpl::stopPool
+
+
+//      Function : BddImpl::workerLoop
+//      Abstract : Body of a worker thread. Sleep until a parallel
+//      operation starts, then steal tasks until it is done.
+void
+BddImpl::workerLoop(const size_t id)
+{
+  BddWorker &w = *_workers[id];
+  size_t gen = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_poolLock);
+      _poolWake.wait(lock, [this, gen] { return _poolStop || _poolGen != gen; });
+      if (_poolStop) {
+        return;
+      } // if
+      gen = _poolGen;
+    }
+
+    while (!_parDone.load(std::memory_order_acquire)) {
+      if (_parPause.load(std::memory_order_relaxed)) {
+        pauseParallel();
+      } else if (!stealTask(w)) {
+        std::this_thread::yield();
+      } // if nothing to do
+    } // while
+
+    {
+      std::lock_guard<std::mutex> lock(_poolLock);
+      if (--_poolBusy == 0) {
+        _poolIdle.notify_all();
+      } // if last
+    }
+  } // while
+} // BddImpl::workerLoop
+
+
+//      Function : BddImpl::stealTask
+//      Abstract : Take the oldest task of some other worker and run it.
+//      Returns false if there was none.
+bool
+BddImpl::stealTask(BddWorker &w)
+{
+  const size_t numWorkers = _workers.size();
+  for (size_t k = 1; k < numWorkers; ++k) {
+    BddWorker &victim = *_workers[(w._id + k) % numWorkers];
+    BddTask *task = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(victim._lock);
+      if (!victim._tasks.empty()) {
+        task = victim._tasks.front();
+        victim._tasks.pop_front();
+      } // if
+    }
+    if (task) {
+      runTask(w, *task);
+      return true;
+    } // if stolen
+  } // for each other worker
+
+  return false;
+} // BddImpl::stealTask
+
+
+//      Function : BddImpl::prepareParallel
+//      Abstract : Get the computed cache and the unique tables ready to
+//      be shared. Returns true if any table grew.
+bool
+BddImpl::prepareParallel()
+{
+  if (_compTbl.empty()) {
+    _compTbl.resize(_compCacheSz);
+  } // if first use
+
+  bool grown = false;
+  for (BddIndex index = 1; index <= _maxIndex; ++index) {
+    if (_uniqTbls[index].prepareShared(*this)) {
+      grown = true;
+    } // if
+  } // for each level
+
+  return grown;
+} // BddImpl::prepareParallel
+
+
+//      Function : BddImpl::beginParallel
+//      Abstract : Wake the workers for a parallel operation.
+void
+BddImpl::beginParallel()
+{
+  _parAbort.store(false, std::memory_order_relaxed);
+  _parDone.store(false, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(_poolLock);
+    _poolBusy = _threads.size();
+    ++_poolGen;
+  }
+  _poolWake.notify_all();
+} // BddImpl::beginParallel
+
+
+//      Function : BddImpl::endParallel
+//      Abstract : Wait for the workers to go back to sleep, then add
+//      their cache counts to the manager's and put the nodes they did
+//      not use back on the free list.
+void
+BddImpl::endParallel()
+{
+  _parDone.store(true, std::memory_order_release);
+  {
+    std::unique_lock<std::mutex> lock(_poolLock);
+    _poolIdle.wait(lock, [this] { return _poolBusy == 0; });
+  }
+
+  mergeParallelCounts();
+  for (auto &w : _workers) {
+    assert(w->_tasks.empty());
+    w->_misses = 0;
+    w->_missMark = 0;
+    for (BDD f : w->_free) {
+      freeNode(f);
+    } // for each unused node
+    w->_free.clear();
+  } // for each worker
+} // BddImpl::endParallel
+
+
+//      Function : BddImpl::pauseParallel
+//      Abstract : Wait while another worker grows the tables.
+void
+BddImpl::pauseParallel()
+{
+  std::unique_lock<std::mutex> lock(_pauseLock);
+  ++_parked;
+  _pauseWake.notify_all();
+  _pauseWake.wait(lock, [this] {
+    return !_parPause.load(std::memory_order_relaxed); });
+  --_parked;
+} // BddImpl::pauseParallel
+
+
+//      Function : BddImpl::growParallel
+//      Abstract : Called by a worker which found a unique table too
+//      full or no node left. Waits for the other workers to pause,
+//      then grows the tables and, with the flat layout, the node
+//      array. Returns false if nothing grew. If another worker is
+//      already doing so, just waits for it and returns true.
+bool
+BddImpl::growParallel()
+{
+  std::unique_lock<std::mutex> lock(_pauseLock);
+  if (_parPause.load(std::memory_order_relaxed)) {
+    lock.unlock();
+    pauseParallel();
+    return true;
+  } // if already pausing
+
+  _parPause.store(true, std::memory_order_relaxed);
+  _pauseWake.wait(lock, [this] { return _parked + 1 == _workers.size(); });
+
+  const size_t curNodes = _curNodes;
+  bool grown = prepareParallel();
+  if (_flat && _nodesFree < PAR_ALLOC_BATCH * _workers.size()) {
+    allocateMoreNodes();
+  } // if flat layout is short of nodes
+  grown = grown || _curNodes > curNodes;
+
+  _parPause.store(false, std::memory_order_relaxed);
+  _pauseWake.notify_all();
+  return grown;
+} // BddImpl::growParallel
+
+
+//      Function : BddImpl::mergeParallelCounts
+//      Abstract : Add the cache counts of the workers since the last
+//      merge to the manager's. A worker's misses only ever go up
+//      during an operation, since its frames keep them to cost the
+//      entries they make.
+void
+BddImpl::mergeParallelCounts()
+{
+  for (auto &w : _workers) {
+    _compLookups += w->_lookups;
+    _compMisses += w->_misses - w->_missMark;
+    _compEvicts += w->_evicts;
+    w->_lookups = 0;
+    w->_missMark = w->_misses;
+    w->_evicts = 0;
+  } // for each worker
+} // BddImpl::mergeParallelCounts
+
+
+//      Function : BddImpl::allocateShared
+//      Abstract : Allocate a node for a worker from its batch, which is
+//      refilled from the free list when empty. The nodes are cleared
+//      and dated as they are taken, while their index is still 0, as
+//      cacheEntryValid() may read the age of a node of another worker
+//      once its index is published. The flat layout cannot
+//      grow while nodes are in use by other threads, so it is grown by
+//      growParallel() with the others paused. Returns the null node if
+//      no node is left.
+BDD
+BddImpl::allocateShared(BDDVec &spare)
+{
+  if (spare.empty()) {
+    std::lock_guard<std::mutex> lock(_allocLock);
+    while (spare.size() < PAR_ALLOC_BATCH && _nodesAllocd < _maxNodes) {
+      if (_nodesFree == 0 && !_flat) {
+        allocateMoreNodes();
+      } // if no node free
+      if (_nodesFree == 0) {
+        break;
+      } // if
+      BDD f = popFree(_nullNode);
+      getNode(f).setHi(0);
+      getNode(f).setLo(0);
+      getAux(f).clear();
+      getAux(f).setGen(_epoch & BDD_GEN_MASK);
+      spare.push_back(f);
+      ++_nodesAllocd;
+      --_nodesFree;
+    } // while
+    _maxAllocd = std::max(_maxAllocd, _nodesAllocd);
+    if (spare.empty()) {
+      return _nullNode;
+    } // if out of nodes
+  } // if batch used up
+
+  BDD rtn = spare.back();
+  spare.pop_back();
+  return rtn;
+} // BddImpl::allocateShared
+
+
+//      Function : BddImpl::makeNodeShared
+//      Abstract : makeNode() for a worker. If the node cannot be added,
+//      grows the tables and tries again. Sets _parAbort if they cannot
+//      grow.
+BDD
+BddImpl::makeNodeShared(BddWorker &w,
+                        const BddIndex index,
+                        BDD hi,
+                        BDD lo)
+{
+  if (hi == lo) {
+    return hi;
+  } // if redundant
+
+  const bool inv = isNegPhase(hi);
+  if (inv) {
+    hi = invert(hi);
+    lo = invert(lo);
+  } // if
+
+  BDD rtn;
+  while (!(rtn = _uniqTbls[index].findOrAddShared(*this, w._free,
+                                                  index, hi, lo))) {
+    if (!growParallel()) {
+      _parAbort.store(true, std::memory_order_relaxed);
+      return _nullNode;
+    } // if nothing grew
+  } // while table full
+
+  return inv ? invert(rtn) : rtn;
+} // BddImpl::makeNodeShared
+
+
+//      Function : BddImpl::getCacheShared
+//      Abstract : getCache() for a worker. A set locked by another
+//      worker is a miss.
+BDD
+BddImpl::getCacheShared(BddWorker &w, CacheOp op, BDD f, BDD g, BDD h)
+{
+  ++w._lookups;
+  CacheSet &set = _compTbl[cacheSetIndex(op, f, g, h)];
+  BDD rtn = _nullNode;
+  if (__atomic_exchange_n(&set._lock, 1, __ATOMIC_ACQUIRE) == 0) {
+    rtn = findCacheEntry(set, op, f, g, h);
+    __atomic_store_n(&set._lock, 0, __ATOMIC_RELEASE);
+  } // if set free
+
+  if (!rtn) {
+    ++w._misses;
+  } // if miss
+  return rtn;
+} // BddImpl::getCacheShared
+
+
+//      Function : BddImpl::insertCacheShared
+//      Abstract : insertCache() for a worker. Nothing is stored if the
+//      set is locked by another worker.
+void
+BddImpl::insertCacheShared(BddWorker &w,
+                           CacheOp op,
+                           BDD f,
+                           BDD g,
+                           BDD h,
+                           BDD r,
+                           size_t cost)
+{
+  CacheSet &set = _compTbl[cacheSetIndex(op, f, g, h)];
+  if (__atomic_exchange_n(&set._lock, 1, __ATOMIC_ACQUIRE) == 0) {
+    if (putCacheEntry(set, op, f, g, h, r, cost) != CACHE_NONE) {
+      ++w._evicts;
+    } // if
+    __atomic_store_n(&set._lock, 0, __ATOMIC_RELEASE);
+  } // if set free
+} // BddImpl::insertCacheShared
+
+} // namespace abide
@@ -11,64 +11,93 @@
 
 namespace abide {
 
+//      Class    : BddNodeAux
+//      Abstract : The fields of a Bdd node which are not needed to
+//      traverse a BDD: the reference count, the mark bits and the
+//      generation in which the node was allocated. The unique table
+//      chain, when there is one, is kept by the manager in a parallel
+//      array. See BddImpl::getLink().
+class BddNodeAux {
+ public:
+  BddNodeAux() = default;
+  ~BddNodeAux() = default;
+
+  BddNodeAux(const BddNodeAux &) = default; // Copy CTOR
+  BddNodeAux &operator=(const BddNodeAux &) = default; // Copy assignment
+  BddNodeAux(BddNodeAux &&) = default; // Move CTOR
+  BddNodeAux &operator=(BddNodeAux &&) = default; // Move assignment
+
+  // Avoid using n=0 unless gc is locked.
+  void setMark(uint32_t n) {
+    assert(n < 2);
+    _marks |= (1<<n); };
+  void clrMark(uint32_t n) {
+    assert(n < 2);
+    _marks &= ~(1<<n); };
+  bool marked(uint32_t n) {
+    assert(n < 2);
+    return _marks & (1<<n); };
+
+  // The low bits of the gc epoch in which the node was allocated.
+  void setGen(uint32_t g) { _gen = g; };
+  uint32_t getGen() const { return _gen; };
+
+  void clear() {
+    _xrefs = 0;
+    _marks = 0;
+    _gen = 0;
+  };
+
+  void incRef() { ++_xrefs; };
+  void decRef() { --_xrefs; };
+  uint32_t numRefs() const { return _xrefs; };
+  void setRefs(uint32_t r) { _xrefs = r; };
+ private:
+  uint32_t _xrefs:24;
+  uint32_t _marks:2;
+  uint32_t _gen:6;
+}; // BddNodeAux
+
+
 //      Class    : BddNode
-//      Abstract : A Bdd node.
+//      Abstract : The fields of a Bdd node read while traversing a
+//      BDD. With STORE_JOINED the BddNodeAux fields follow them in the
+//      same record. With STORE_SPLIT they are held in a parallel array.
+//      See BddImpl::getAux().
 class BddNode {
  public:
   BddNode() = default;
   ~BddNode() = default;
 
-#ifdef BANKEDMEM
-  BddNode(const BddNode &) = delete; // Copy CTOR
-  BddNode &operator=(const BddNode &) = delete; // Copy assignment
-  BddNode(BddNode &&) = delete; // Move CTOR
-  BddNode &operator=(BddNode &&) = delete; // Move assignment
-#else
   BddNode(const BddNode &) = default; // Copy CTOR
   BddNode &operator=(const BddNode &) = default; // Copy assignment
   BddNode(BddNode &&) = default; // Move CTOR
   BddNode &operator=(BddNode &&) = default; // Move assignment
-#endif
 
   void setIndex(BddIndex i) { _index = i; };
   BddIndex getIndex() const { return _index; };
 
+  // For a node made while other threads may read its index: the other
+  // fields are set before the index is published. See
+  // BddImpl::cacheEntryValid().
+  void publishIndex(BddIndex i) {
+    __atomic_store_n(&_index, i, __ATOMIC_RELEASE); };
+  BddIndex loadIndex() const {
+    return __atomic_load_n(&_index, __ATOMIC_ACQUIRE); };
+
   void setHi(BDD n) { _hi = n;};
   BDD getHi() const { return _hi; };
   void setLo(BDD n) { _lo = n;};
   BDD getLo() const { return _lo; };
 
-  void setNext(BDD n) { _next = n;};
-  BDD getNext() const { return _next; };
-
-  // Avoid using n=0 unless gc is locked.
-  void setMark(uint32_t n) {
-    assert(n < 8);
-    _marks |= (1<<n); };
-  void clrMark(uint32_t n) {
-    assert(n < 8);
-    _marks &= ~(1<<n); };
-  bool marked(uint32_t n) {
-    assert(n < 8);
-    return _marks & (1<<n); };
-
   void clear() {
-    _hi = _lo = _next = 0;
-    _index = _xrefs = 0;
-    _marks = 0;
+    _hi = _lo = 0;
+    _index = 0;
   };
-
-  void incRef() { ++_xrefs; };
-  void decRef() { --_xrefs; };
-  uint32_t numRefs() const { return _xrefs; };
-  void setRefs(uint32_t r) { _xrefs = r; };
  private:
   BDD _hi;
   BDD _lo;
-  BDD _next;
   BddIndex _index;
-  uint32_t _xrefs:24;
-  uint32_t _marks:8;
 }; // BddNode
 
 } // namespace abide
@@ -282,13 +282,12 @@ combineDnf(Bdd x, Dnf d0, Dnf d1, Dnf d2)
 Bdd
 dnf2Bdd(const BddMgr &mgr, Dnf &dnf)
 {
-  Bdd sum = mgr.getZero();
+  BddVec terms;
   for (auto &term : dnf) {
-    Bdd prod = term2Bdd(mgr, term);
-    sum += prod;
+    terms.push_back(term2Bdd(mgr, term));
   } // for
 
-  return sum;
+  return mgr.disjoin(terms);
 } // dnf2Bdd
 
 
@@ -297,12 +296,12 @@ dnf2Bdd(const BddMgr &mgr, Dnf &dnf)
 Bdd
 term2Bdd(const BddMgr &mgr, Term &term)
 {
-  Bdd prod = mgr.getOne();
+  BddVec lits;
   for (auto &lit : term) {
-    prod *= mgr.getLit(lit);
+    lits.push_back(mgr.getLit(lit));
   } // for
 
-  return prod;
+  return mgr.conjoin(lits);
 } // term2Bdd
 
 
@@ -7,53 +7,154 @@
 #define CACHESTATS_H
 
 #include "Defines.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <iomanip>
+#include <iostream>
+
+// Operations whose results are kept in the computed cache. CACHE_NONE
+// tags an empty entry.
+enum CacheOp {
+  CACHE_NONE = 0,
+  CACHE_AND,
+  CACHE_XOR,
+  CACHE_RESTRICT,
+  CACHE_ITE,
+  CACHE_ANDEXISTS,
+  CACHE_XOREXISTS,
+  CACHE_EXISTS,
+  CACHE_UNIQUE,
+  NUM_CACHE_OPS
+}; // CacheOp
 
 struct CacheStats {
 #ifdef CACHESTATS
+  using Timer = std::chrono::steady_clock::time_point;
+  Timer startTimer() const { return std::chrono::steady_clock::now(); };
+  void addUniqLatency(Timer start) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+    size_t bin = 0;
+    while (bin + 1 < NUM_LATENCY_BINS && (2LL << bin) <= ns) {
+      ++bin;
+    } // while
+    ++_uniqLatency[bin];
+  };
   void incUniqAccess() { ++_uniqAccess; };
   void incUniqChain()  { ++_uniqChain;  };
   void incUniqHit()    { ++_uniqHit;    };
   void incUniqMiss()   { ++_uniqMiss;   };
-  void incCompHit()    { ++_compHit;    };
-  void incCompMiss()   { ++_compMiss;   };
+  void incCompHit(CacheOp op)  { ++_compHit[op];  };
+  void incCompMiss(CacheOp op) { ++_compMiss[op]; };
+  void incCompEvict(CacheOp op) { ++_compEvict[op]; };
+  void incCompResize() { ++_compResize; };
+  void addGCPause(double ms) {
+    ++_numGCs;
+    _gcTime += ms;
+    _gcMaxPause = std::max(_gcMaxPause, ms);
+  };
   void print() {
-    double hitRate = (_uniqAccess > 0 ?
-                      100.0 * static_cast<double>(_uniqHit) /
-                      static_cast<double>(_uniqAccess) :
-                      0.0);
+    using std::cout;
+    using std::endl;
     cout << "Cache Statistics\n"
          << "----------------\n"
          << "Unique Access: " << _uniqAccess << endl
          << "Unique Chain : " << _uniqChain  << endl
          << "Unique Hit   : " << _uniqHit    << endl
          << "Unique Miss  : " << _uniqMiss   << endl
-         << "Hit Rate     : " << std::setprecision(4) << hitRate << "%" << endl;
-    hitRate = ((_compMiss + _compHit > 0) ?
-               100.0 * static_cast<double>(_compHit) /
-               static_cast<double>(_compHit + _compMiss):
-               0.0);
-    cout << "Compute Hit  : " << _compHit << endl
-         << "Compute Miss : " << _compMiss <<endl
-         << "HitRate      : " << std::setprecision(4) << hitRate << "%" << endl;
+         << "Hit Rate     : " << std::setprecision(4)
+         << rate(_uniqHit, _uniqAccess) << "%" << endl;
+    printLatency();
+
+    static const char *names[NUM_CACHE_OPS] = {
+      "", "and", "xor", "restrict", "ite", "andExists", "xorExists",
+      "exists", "unique"
+    };
+    size_t hits = 0;
+    size_t misses = 0;
+    cout << std::setw(12) << "Compute"
+         << std::setw(12) << "Hit"
+         << std::setw(12) << "Miss"
+         << std::setw(12) << "Evict"
+         << std::setw(10) << "HitRate" << endl;
+    for (int op = CACHE_AND; op < NUM_CACHE_OPS; ++op) {
+      cout << std::setw(12) << names[op]
+           << std::setw(12) << _compHit[op]
+           << std::setw(12) << _compMiss[op]
+           << std::setw(12) << _compEvict[op]
+           << std::setw(9) << std::setprecision(4)
+           << rate(_compHit[op], _compHit[op] + _compMiss[op]) << "%" << endl;
+      hits += _compHit[op];
+      misses += _compMiss[op];
+    } // for each op
+    cout << "Compute Hit  : " << hits << endl
+         << "Compute Miss : " << misses <<endl
+         << "HitRate      : " << std::setprecision(4)
+         << rate(hits, hits + misses) << "%" << endl
+         << "Resizes      : " << _compResize << endl
+         << "GC Count     : " << _numGCs << endl
+         << "GC Time      : " << _gcTime << " ms" << endl
+         << "GC Max Pause : " << _gcMaxPause << " ms" << endl;
   } // print
+
+  // Histogram of findOrAdd() times. Bin i counts calls that took
+  // [2^i, 2^(i+1)) ns.
+  void printLatency() {
+    using std::cout;
+    using std::endl;
+    size_t total = 0;
+    for (auto n : _uniqLatency) {
+      total += n;
+    } // for
+    cout << "Unique Latency (ns)" << endl;
+    size_t sum = 0;
+    for (size_t bin = 0; bin < NUM_LATENCY_BINS; ++bin) {
+      if (_uniqLatency[bin]) {
+        sum += _uniqLatency[bin];
+        cout << "  < " << std::setw(12) << (2ULL << bin) << ": "
+             << std::setw(12) << _uniqLatency[bin]
+             << std::setw(10) << std::setprecision(6)
+             << rate(sum, total) << "%" << endl;
+      } // if
+    } // for each bin
+  } // printLatency
 #else
+  using Timer = int;
+  Timer startTimer() const { return 0; };
+  void addUniqLatency(Timer) {};
   void incUniqAccess() {};
   void incUniqChain()  {};
   void incUniqHit() {};
   void incUniqMiss() {};
-  void incCompHit() {};
-  void incCompMiss() {};
+  void incCompHit(CacheOp) {};
+  void incCompMiss(CacheOp) {};
+  void incCompEvict(CacheOp) {};
+  void incCompResize() {};
+  void addGCPause(double) {};
   void print() {};
 #endif
 
  private:
+  static double rate(size_t n, size_t d) {
+    return (d > 0
+            ? 100.0 * static_cast<double>(n) / static_cast<double>(d)
+            : 0.0);
+  } // rate
+
   size_t _uniqAccess = 0;
   size_t _uniqChain = 0;
   size_t _uniqHit = 0;
   size_t _uniqMiss = 0;
-  size_t _compHit = 0;
-  size_t _compMiss = 0;
+  static const size_t NUM_LATENCY_BINS = 40;
+  size_t _uniqLatency[NUM_LATENCY_BINS] = {};
+  size_t _compHit[NUM_CACHE_OPS] = {};
+  size_t _compMiss[NUM_CACHE_OPS] = {};
+  size_t _compEvict[NUM_CACHE_OPS] = {};
+  size_t _compResize = 0;
+  size_t _numGCs = 0;
+  double _gcTime = 0.0;
+  double _gcMaxPause = 0.0;
 }; // struct CacheStats
 
 #endif // CACHESTATS_H
@@ -4,9 +4,14 @@
 //
 
 #include <Bdd.h>
+#include <BddImage.h>
 #include <BddUtils.h>
 #include <BddInterval.h>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 using std::cout;
 using std::endl;
 
@@ -28,6 +33,18 @@ void testXor();
 void testDnf();
 void testInterval();
 void testMisc();
+void testCache();
+void testBreadthFirst();
+void testParallel();
+void testIndependent();
+void testTransfer();
+void testConjoin();
+void testQuantify();
+void testVectorCompose();
+void testPermute();
+void testImage();
+void testReach();
+void testSatCount();
 
 void printDnf(Dnf &dnf);
 void printCube(Bdd cube);
@@ -53,6 +70,18 @@ main()
   testDnf();
   testInterval();
   testMisc();
+  testCache();
+  testBreadthFirst();
+  testParallel();
+  testIndependent();
+  testTransfer();
+  testConjoin();
+  testQuantify();
+  testVectorCompose();
+  testPermute();
+  testImage();
+  testReach();
+  testSatCount();
 
   return 0;
 } // main
@@ -137,6 +166,138 @@ testMemBasic()
   VALIDATE(mgr.nodesAllocd() == 2);
   VALIDATE(mgr.checkMem());
 
+  // Unique tables are only allocated for levels with nodes, so a
+  // manager with many variables and few nodes is cheap.
+  BddMgr sparse(100000);
+  {
+    Bdd F = sparse.getOne();
+    for (BddLit lit = 1; lit <= 100000; lit += 997) {
+      F *= sparse.getLit(lit);
+    } // for
+    VALIDATE(F.countNodes() == 102);
+  }
+  sparse.gc(true);
+  VALIDATE(sparse.nodesAllocd() == 2);
+  VALIDATE(sparse.checkMem());
+
+  // A table starts small, so a node on every level is cheap too.
+  BddMgr dense(100000);
+  {
+    Bdd F = dense.getOne();
+    for (BddLit lit = 100000; lit > 0; --lit) {
+      F *= dense.getLit(lit);
+    } // for
+    VALIDATE(F.countNodes() == 100001);
+    VALIDATE(F.supportSize() == 100000);
+  }
+  dense.gc(true);
+  VALIDATE(dense.nodesAllocd() == 2);
+  VALIDATE(dense.checkMem());
+
+  // reset() frees every node once no Bdd refers to them. The
+  // manager can then be used again.
+  BddMgr pool(8);
+  for (int round = 0; round < 2; ++round) {
+    {
+      Bdd P = pool.getOne();
+      for (BddLit lit = 1; lit <= 8; lit += 2) {
+        P *= pool.getLit(lit) + pool.getLit(lit + 1);
+      } // for
+      VALIDATE(P.countNodes() == 9);
+      VALIDATE(!pool.reset());
+    }
+    VALIDATE(pool.reset());
+    VALIDATE(pool.nodesAllocd() == 2);
+    VALIDATE(pool.checkMem());
+  } // for each round
+
+  // compact() releases the banks left empty after a peak without
+  // moving nodes held by Bdds.
+  BddMgr peak(32);
+  {
+    BddVec v;
+    for (BddLit lit = 1; lit <= 32; ++lit) {
+      v.push_back(peak.getLit(lit));
+    } // for
+    Bdd keep = v[0] * v[31] + v[15] * ~v[16];
+    {
+      Bdd S = peak.getZero();
+      for (size_t i = 0; i < 16; ++i) {
+        S = S + (v[i] ^ v[i + 16]);
+      } // for
+      VALIDATE(S.countNodes() > 60000);
+    }
+    VALIDATE(peak.compact() > 0);
+    VALIDATE(peak.checkMem());
+    VALIDATE(keep == v[0] * v[31] + v[15] * ~v[16]);
+    Bdd T = peak.getZero();
+    for (size_t i = 0; i < 16; ++i) {
+      T = T + (v[i] * v[i + 16]);
+    } // for
+    VALIDATE(T.countNodes() > 60000);
+    VALIDATE(T == ~(~(v[0] * v[16]) * ~(T.restrict(~v[0]))));
+  }
+  VALIDATE(peak.compact() > 0);
+  VALIDATE(peak.nodesAllocd() == 2);
+  VALIDATE(peak.checkMem());
+
+  // A node made at the peak pins the top bank, so the banks released
+  // below it leave a hole and node ids run past the slots held.
+  {
+    BddVec v;
+    for (BddLit lit = 1; lit <= 32; ++lit) {
+      v.push_back(peak.getLit(lit));
+    } // for
+    Bdd top;
+    {
+      Bdd S = peak.getZero();
+      for (size_t i = 0; i < 16; ++i) {
+        S = S + (v[i] ^ v[i + 16]);
+      } // for
+      top = v[1] * v[3] * v[5] * v[7];
+    }
+    VALIDATE(peak.compact() > 0);
+    VALIDATE(peak.checkMem());
+    Bdd T = peak.getZero();
+    for (size_t i = 0; i < 16; ++i) {
+      T = T + (v[i] * v[i + 16]);
+    } // for
+    VALIDATE(T.countNodes() > 60000);
+    VALIDATE(top == v[1] * v[3] * v[5] * v[7]);
+    VALIDATE(peak.checkMem());
+  }
+
+  // Every combination of strategies behaves the same.
+  for (BddMemMode mode : {MEM_HEAP, MEM_MMAP, MEM_HUGE}) {
+    for (BddNodeLayout layout : {LAYOUT_BANKED, LAYOUT_FLAT}) {
+      for (int flags = 0; flags < 16; ++flags) {
+        BddConfig config;
+        config.memMode = mode;
+        config.layout = layout;
+        config.localAlloc = flags & 1;
+        config.incrUniq = flags & 2;
+        config.uniqMode = (flags & 4) ? UNIQ_CHAINED : UNIQ_OPEN;
+        config.nodeStore = (flags & 8) ? STORE_SPLIT : STORE_JOINED;
+        BddMgr alt(24, 0, 0, config);
+        {
+          Bdd S = alt.getZero();
+          for (BddLit lit = 1; lit <= 12; ++lit) {
+            S = S + (alt.getLit(lit) ^ alt.getLit(lit + 12));
+          } // for
+          VALIDATE(S.countNodes() == 12285);
+          VALIDATE(S == ~(~S));
+          alt.gc(true);
+          VALIDATE(alt.checkMem());
+          alt.reorder();
+          VALIDATE(S.countNodes() < 100);
+        }
+        VALIDATE(alt.compact() > 0);
+        VALIDATE(alt.nodesAllocd() == 2);
+        VALIDATE(alt.checkMem());
+      } // for each flag setting
+    } // for each layout
+  } // for each mode
+
   cout << endl;
 } // testMemBasic
 
@@ -469,6 +630,10 @@ testAndExists()
     VALIDATE(H1 == H3);
   }
 
+  // Both factors reduce to one before the cube is used up.
+  VALIDATE(mgr.andExists(f + g, mgr.getOne(), g) == mgr.getOne());
+  VALIDATE(mgr.andExists(a*f + ~g, mgr.getOne(), g) == mgr.getOne());
+
   Bdd F1 = (b^c^d);
   Bdd F2 = (c^(e+f));
   Bdd cube = a*c;
@@ -848,6 +1013,38 @@ testMisc()
   F = ~F;
   VALIDATE(F.isCube());
 
+  // Operations on BDDs as deep as the variable order do not recurse,
+  // so they are limited by memory rather than the call stack. 100000
+  // levels is well past what a recursive apply can reach with the
+  // default 8 MB stack, yet the manager needs only a few MB.
+  {
+    const BddLit N = 100000;
+    BddMgr deep(N);
+    Bdd last = deep.getLit(N);
+    Bdd P = last;
+    Bdd Q = ~last;
+    for (BddLit lit = N - 1; lit > 0; --lit) {
+      P = deep.getLit(lit) * P;
+      Q = deep.getLit(lit) * Q;
+    } // for
+    VALIDATE(P.countNodes() == N + 1);
+    Bdd R = P + Q;
+    VALIDATE(R.countNodes() == N);
+    VALIDATE((P ^ Q) == R);
+    VALIDATE(deep.ite(P, Q, P) == deep.getZero());
+    VALIDATE(deep.andExists(P, P, last) == R);
+    VALIDATE(P.restrict(R) == last);
+    VALIDATE(P.restrict(~last) == deep.getZero());
+    VALIDATE(Q.restrict(~last) == R);
+    VALIDATE(R.supportSize() == N - 1);
+    VALIDATE(P.satCount(N) == 1.0);
+    VALIDATE(R.satCount128(N) == 2);
+    VALIDATE(R.satCountStr(N) == "2");
+    auto strs = deep.satCountStr(BddVec{P, Q, R}, N);
+    VALIDATE(strs[0] == "1" && strs[1] == "1" && strs[2] == "2");
+    VALIDATE(std::isinf((~P).satCount(N)));
+  }
+
   mgr.printStats();
 } // testMisc
 
@@ -907,3 +1104,969 @@ testInterval()
   H.print();
 } // testInterval
 
+
+
+//      Function : testCache
+//      Abstract : Test that results are correct when the computed
+//      cache is tiny and every operation shares a single set.
+void
+testCache()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Computed Cache Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  BddMgr mgr(12, 0, 2);
+  BddVec x;
+  for (BddLit lit = 1; lit <= 12; ++lit) {
+    x.push_back(mgr.getLit(lit));
+  } // for
+
+  Bdd P = mgr.getZero();
+  Bdd Q = mgr.getOne();
+  for (auto &v : x) {
+    P = P ^ v;
+    Q = mgr.ite(v, ~Q, Q);
+  } // for
+  VALIDATE(P == ~Q);
+  VALIDATE(P.countNodes() == 13);
+
+  Bdd F = (x[0] + x[1]) * (x[2] + x[3]) * (x[4] + x[5]);
+  Bdd G = x[0]*x[2]*x[4] + x[0]*x[2]*x[5] + x[0]*x[3]*x[4] + x[0]*x[3]*x[5]
+    + x[1]*x[2]*x[4] + x[1]*x[2]*x[5] + x[1]*x[3]*x[4] + x[1]*x[3]*x[5];
+  VALIDATE(F == G);
+
+  Bdd cube = x[0] * x[1];
+  VALIDATE(mgr.andExists(F, mgr.getOne(), cube) == (x[2] + x[3]) * (x[4] + x[5]));
+  VALIDATE(F.restrict(~x[0] * ~x[1]).isZero());
+  VALIDATE(F <= (x[0] + x[1]));
+
+  // The cache shrinks once a collection frees most of the nodes and
+  // does not grow beyond the ratio set.
+  BddMgr mgr2(16, 0, 1<<16);
+  size_t initSz = mgr2.cacheSize();
+  mgr2.setCacheRatio(0.0);
+  {
+    Bdd S = mgr2.getZero();
+    for (BddLit lit = 1; lit <= 16; ++lit) {
+      S = S + (mgr2.getLit(lit) ^ mgr2.getLit(17 - lit)) * mgr2.getLit(lit % 3 + 1);
+    } // for
+    VALIDATE(mgr2.cacheSize() == initSz);
+  }
+  mgr2.gc(true);
+  VALIDATE(mgr2.cacheSize() < initSz);
+
+  // Entries made before a collection must not be used once their
+  // nodes have been freed and reused.
+  BddMgr mgr3(4);
+  Bdd a = mgr3.getLit(1);
+  Bdd b = mgr3.getLit(2);
+  Bdd c = mgr3.getLit(3);
+  Bdd d = mgr3.getLit(4);
+  {
+    Bdd T = (a ^ b) * (c ^ d);
+  }
+  mgr3.gc(true);
+  Bdd U = (a + c) * (b + d);
+  Bdd V = (a ^ b) * (c ^ d);
+  VALIDATE(V == (a*~b + ~a*b) * (c*~d + ~c*d));
+  VALIDATE(U == a*b + a*d + c*b + c*d);
+
+  // The cache is kept through reordering. Results computed afterward
+  // must agree with those computed before.
+  BddMgr mgr4(8);
+  BddVec y;
+  for (BddLit lit = 1; lit <= 8; ++lit) {
+    y.push_back(mgr4.getLit(lit));
+  } // for
+  Bdd M = y[0]*y[4] + y[1]*y[5] + y[2]*y[6] + y[3]*y[7];
+  Bdd N = (y[0] ^ y[4]) + (y[1] ^ y[5]);
+  Bdd MN = M * N;
+  Bdd R = M.restrict(y[0]);
+  mgr4.reorder();
+  VALIDATE(mgr4.getVarOrder()[1] != 1 || mgr4.getVarOrder()[2] != 2);
+  Bdd W = (y[2] ^ y[6]) * (y[3] + y[7]);
+  VALIDATE(M * N == MN);
+  VALIDATE((y[0]*y[4] + y[1]*y[5] + y[2]*y[6] + y[3]*y[7]) == M);
+  VALIDATE(W == (y[2]*~y[6] + ~y[2]*y[6]) * ~(~y[3] * ~y[7]));
+  VALIDATE(M.restrict(y[0]) * y[0] == R * y[0]);
+
+  // The cache is kept small while the operands are built, then
+  // allowed to grow. Its size is reviewed as each operation ends,
+  // never during one, so a single large operation at most doubles
+  // it. This is also done while gc is locked.
+  BddMgr mgr5(28);
+  size_t smallSz = mgr5.cacheSize();
+  mgr5.setCacheRatio(0.0);
+  {
+    Bdd S = mgr5.getZero();
+    Bdd T = mgr5.getZero();
+    for (BddLit lit = 1; lit <= 14; ++lit) {
+      S = S + (mgr5.getLit(lit) ^ mgr5.getLit(lit + 14));
+      S = S * ~(mgr5.getLit(lit) * mgr5.getLit(29 - lit));
+      T = T ^ (mgr5.getLit(lit) * mgr5.getLit(29 - lit));
+    } // for
+    VALIDATE(mgr5.cacheSize() == smallSz);
+    mgr5.setCacheRatio(1.0);
+    mgr5.lockGC();
+    Bdd P = S * T;
+    mgr5.unlockGC();
+    VALIDATE(P.countNodes() > 20 * smallSz);
+    VALIDATE(mgr5.cacheSize() == 2 * smallSz);
+  }
+} // testCache
+
+
+//      Function : testBreadthFirst
+//      Abstract : Test that breadth-first apply agrees with ite(),
+//      which is computed depth first, and fails cleanly when out of
+//      nodes.
+void
+testBreadthFirst()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Breadth-First Apply Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  BddMgr mgr;
+  mgr.setBreadthFirst(1);
+  const int N = 20;
+  BddVec x;
+  for (int idx = 0; idx < N; ++idx) {
+    x.push_back(mgr.getLit(idx + 1));
+  } // for
+
+  Bdd one = mgr.getOne();
+  Bdd zero = mgr.getZero();
+  Bdd F = zero;
+  Bdd G = zero;
+  for (int idx = 0; idx < N/2; ++idx) {
+    F += x[idx] * x[idx + N/2];
+    G ^= x[idx] * x[N - 1 - idx];
+  } // for
+  VALIDATE(F.countNodes() == 2047);
+  VALIDATE(F * G == mgr.ite(F, G, zero));
+  VALIDATE(F + G == mgr.ite(F, one, G));
+  VALIDATE((F ^ G) == mgr.ite(F, ~G, G));
+  VALIDATE(F.nand2(G) == mgr.ite(F, ~G, one));
+  VALIDATE(F.nor2(G) == mgr.ite(F, zero, ~G));
+  VALIDATE(F.xnor2(G) == mgr.ite(F, G, ~G));
+  VALIDATE(F.implies(G) == mgr.ite(F, G, one));
+
+  Bdd H = x[0] * ~x[N - 1];
+  mgr.gc(true);
+  mgr.setMaxNodes(mgr.nodesAllocd() + 16);
+  VALIDATE(!(F ^ (G + H)).valid());
+  VALIDATE(mgr.checkMem());
+  mgr.setMaxNodes(1<<20);
+  VALIDATE((F ^ (G + H)) == mgr.ite(F, ~(G + H), G + H));
+  VALIDATE(mgr.checkMem());
+} // testBreadthFirst
+
+
+//      Function : testParallel
+//      Abstract : Test that operations shared by worker threads agree
+//      with the same operations in a sequential manager, survive gc and
+//      reordering between them and fail cleanly when out of nodes.
+void
+testParallel()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Parallel Apply Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  const int N = 24;
+  BddConfig config;
+  config.threads = 4;
+  BddMgr mgr(N, 1<<24, 1<<12, config);
+  BddMgr seq(N, 1<<24, 1<<12);
+  auto build = [N](BddMgr &m, Bdd &F, Bdd &G) {
+    F = G = m.getZero();
+    for (int idx = 0; idx < N/2; ++idx) {
+      F += m.getLit(idx + 1) * m.getLit(idx + N/2 + 1);
+      G ^= m.getLit(idx + 1) * m.getLit(N - idx);
+    } // for
+  }; // build
+  Bdd F, G, sF, sG;
+  build(mgr, F, G);
+  build(seq, sF, sG);
+  VALIDATE(F.countNodes() == 8191);
+  VALIDATE((F * G).countNodes() == (sF * sG).countNodes());
+  VALIDATE((F ^ G).countNodes() == (sF ^ sG).countNodes());
+  VALIDATE(F * G == ~(~F + ~G));
+  VALIDATE((F ^ G) == (F * ~G) + (~F * G));
+  VALIDATE(mgr.ite(F, G, ~G) == F.xnor2(G));
+
+  Bdd cube = mgr.getOne();
+  Bdd sCube = seq.getOne();
+  for (int idx = 1; idx <= N; idx += 3) {
+    cube *= mgr.getLit(idx);
+    sCube *= seq.getLit(idx);
+  } // for
+  Bdd E = mgr.andExists(F, G, cube);
+  VALIDATE(E.countNodes() == seq.andExists(sF, sG, sCube).countNodes());
+  VALIDATE(mgr.andExists(F, G, mgr.getOne()) == F * G);
+  Bdd X = mgr.applyExists(F, G, cube, XOR);
+  VALIDATE(X.countNodes() == seq.applyExists(sF, sG, sCube, XOR).countNodes());
+  VALIDATE(X == (F ^ G).exists(cube));
+  VALIDATE((F ^ G).unique(cube).countNodes()
+           == (sF ^ sG).unique(sCube).countNodes());
+  VALIDATE(mgr.checkMem());
+
+  mgr.gc(true);
+  mgr.reorder();
+  VALIDATE((F ^ G) == (F * ~G) + (~F * G));
+  VALIDATE(mgr.andExists(F, G, cube) == E);
+  VALIDATE(mgr.checkMem());
+
+  Bdd H = mgr.getLit(1) * ~mgr.getLit(N);
+  mgr.gc(true);
+  mgr.setMaxNodes(mgr.nodesAllocd() + 16);
+  VALIDATE(!(F ^ (G + H)).valid());
+  VALIDATE(mgr.checkMem());
+  mgr.setMaxNodes(1<<24);
+  VALIDATE((F ^ (G + H)) == mgr.ite(F, ~(G + H), G + H));
+  VALIDATE(mgr.checkMem());
+
+  config.layout = LAYOUT_FLAT;
+  BddMgr flat(N, 1<<24, 1<<12, config);
+  Bdd fF, fG;
+  build(flat, fF, fG);
+  VALIDATE((fF * fG).countNodes() == (sF * sG).countNodes());
+  VALIDATE((fF ^ fG).countNodes() == (sF ^ sG).countNodes());
+  VALIDATE(flat.checkMem());
+
+  config.layout = LAYOUT_BANKED;
+  config.uniqMode = UNIQ_CHAINED;
+  BddMgr chained(N, 1<<24, 1<<12, config);
+  Bdd cF, cG;
+  build(chained, cF, cG);
+  VALIDATE((cF * cG).countNodes() == (sF * sG).countNodes());
+  VALIDATE((cF ^ cG).countNodes() == (sF ^ sG).countNodes());
+  VALIDATE(chained.checkMem());
+
+  config.uniqMode = UNIQ_OPEN;
+  config.nodeStore = STORE_SPLIT;
+  BddMgr split(N, 1<<24, 1<<12, config);
+  Bdd pF, pG;
+  build(split, pF, pG);
+  VALIDATE((pF * pG).countNodes() == (sF * sG).countNodes());
+  VALIDATE((pF ^ pG).countNodes() == (sF ^ sG).countNodes());
+  VALIDATE(split.checkMem());
+} // testParallel
+
+
+//      Function : testIndependent
+//      Abstract : Managers used at once by threads of their own,
+//      some of them with workers, get the same results as one used
+//      alone.
+void
+testIndependent()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Independent Manager Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  const int N = 20;
+  const size_t numMgrs = 4;
+  auto work = [N](BddMgr &m, std::vector<size_t> &sizes) {
+    Bdd F = m.getZero();
+    Bdd G = m.getZero();
+    for (int idx = 0; idx < N/2; ++idx) {
+      F += m.getLit(idx + 1) * m.getLit(idx + N/2 + 1);
+      G ^= m.getLit(idx + 1) * m.getLit(N - idx);
+    } // for
+    sizes.push_back((F * G).countNodes());
+    sizes.push_back((F ^ G).countNodes());
+    m.gc(true);
+    m.reorder();
+    sizes.push_back(F.countNodes());
+    sizes.push_back((F + G).countNodes());
+    m.gc(true);
+  }; // work
+
+  std::vector<size_t> alone;
+  {
+    BddMgr m(N, 1<<20);
+    work(m, alone);
+  }
+
+  std::vector<std::unique_ptr<BddMgr>> mgrs;
+  for (size_t k = 0; k < numMgrs; ++k) {
+    BddConfig config;
+    config.threads = (k % 2) ? 2 : 1;
+    mgrs.push_back(std::make_unique<BddMgr>(N, 1<<20, 0, config));
+  } // for each manager
+  std::vector<std::vector<size_t>> sizes(numMgrs);
+  std::vector<std::thread> threads;
+  for (size_t k = 0; k < numMgrs; ++k) {
+    threads.emplace_back([&work, &mgrs, &sizes, k] {
+      work(*mgrs[k], sizes[k]);
+    });
+  } // for each manager
+  for (auto &thread : threads) {
+    thread.join();
+  } // for each thread
+
+  for (size_t k = 0; k < numMgrs; ++k) {
+    VALIDATE(sizes[k] == alone);
+    VALIDATE(mgrs[k]->checkMem());
+  } // for each manager
+} // testIndependent
+
+
+//      Function : testTransfer
+//      Abstract : Copying BDDs between managers with the same and with
+//      different variable orders.
+void
+testTransfer()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Transfer Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  const int N = 16;
+  auto build = [N](BddMgr &m, Bdd &F, Bdd &G) {
+    F = G = m.getZero();
+    for (int idx = 0; idx < N/2; ++idx) {
+      F += m.getLit(idx + 1) * m.getLit(idx + N/2 + 1);
+      G ^= m.getLit(idx + 1) * ~m.getLit(N - idx);
+    } // for
+  }; // build
+
+  BddMgr src(N);
+  Bdd F, G;
+  build(src, F, G);
+
+  // Variables new to the destination keep the order of the source.
+  BddMgr same(0);
+  Bdd sF = same.transfer(F);
+  VALIDATE(sF.getMgr() == &same);
+  VALIDATE(sF.countNodes() == F.countNodes());
+  VALIDATE(same.getVarOrder() == src.getVarOrder());
+
+  // With the order reversed, the copies are the same functions.
+  BddMgr rev(0);
+  for (BddLit lit = N; lit > 0; --lit) {
+    rev.getLit(lit);
+  } // for
+  Bdd rF, rG;
+  build(rev, rF, rG);
+  BddVec copies = rev.transfer(BddVec{F, G, ~F, F * G, src.getOne(), Bdd()});
+  VALIDATE(copies[0] == rF);
+  VALIDATE(copies[1] == rG);
+  VALIDATE(copies[2] == ~rF);
+  VALIDATE(copies[3] == rF * rG);
+  VALIDATE(copies[4].isOne());
+  VALIDATE(!copies[5].valid());
+  VALIDATE(rev.checkMem());
+
+  // And back again.
+  VALIDATE(src.transfer(copies[0]) == F);
+  VALIDATE(src.transfer(BddVec{copies[1], F})[1] == F);
+
+  // Shared nodes are copied once.
+  BddMgr batch(0);
+  BddVec both = batch.transfer(BddVec{F, G});
+  VALIDATE(batch.countNodes(both) == src.countNodes(BddVec{F, G}));
+  VALIDATE(batch.nodesAllocd() <= src.countNodes(BddVec{F, G}) + N);
+
+  // Cones built in managers of their own are combined in another.
+  BddMgr lo(N);
+  BddMgr hi(N);
+  Bdd loF = lo.getZero();
+  Bdd hiF = hi.getZero();
+  for (int idx = 0; idx < N/2; ++idx) {
+    BddMgr &m = (idx < N/4) ? lo : hi;
+    Bdd &part = (idx < N/4) ? loF : hiF;
+    part += m.getLit(idx + 1) * m.getLit(idx + N/2 + 1);
+  } // for
+  BddMgr dst(N);
+  Bdd dF = dst.getZero();
+  for (const Bdd &part : dst.transfer(BddVec{loF, hiF})) {
+    dF += part;
+  } // for
+  VALIDATE(dF.countNodes() == F.countNodes());
+  VALIDATE(src.transfer(dF) == F);
+  VALIDATE(dst.checkMem());
+} // testTransfer
+
+
+//      Function : testConjoin
+//      Abstract : N-ary conjunction and disjunction.
+void
+testConjoin()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Conjoin Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  const int N = 16;
+  BddMgr mgr(N);
+  BddVec lits;
+  BddVec clauses;
+  BddVec terms;
+  Bdd cube = mgr.getOne();
+  Bdd negCube = mgr.getOne();
+  Bdd cnf = mgr.getOne();
+  Bdd dnf = mgr.getZero();
+  for (int idx = 1; idx <= N/2; ++idx) {
+    Bdd a = mgr.getLit(idx);
+    Bdd b = mgr.getLit(N + 1 - idx);
+    lits.push_back(a);
+    cube *= a;
+    negCube *= ~a;
+    clauses.push_back(a + ~b);
+    cnf *= a + ~b;
+    terms.push_back(~a * b);
+    dnf += ~a * b;
+  } // for
+
+  VALIDATE(mgr.conjoin(BddVec()).isOne());
+  VALIDATE(mgr.disjoin(BddVec()).isZero());
+  VALIDATE(mgr.conjoin(lits) == cube);
+  VALIDATE(mgr.disjoin(lits) == ~negCube);
+  VALIDATE(mgr.conjoin(clauses) == cnf);
+  VALIDATE(mgr.disjoin(terms) == dnf);
+  VALIDATE(mgr.disjoin(terms) == ~cnf);
+  VALIDATE(mgr.conjoin(BddVec{cnf}) == cnf);
+  VALIDATE(mgr.conjoin(BddVec{cnf, mgr.getOne(), cnf}) == cnf);
+
+  BddVec withZero = clauses;
+  withZero.insert(withZero.begin() + 3, mgr.getZero());
+  VALIDATE(mgr.conjoin(withZero).isZero());
+  VALIDATE(mgr.disjoin(BddVec{dnf, mgr.getOne()}).isOne());
+  VALIDATE(!mgr.conjoin(BddVec{cnf, Bdd()}).valid());
+
+  // A contradiction is found however the operands are ordered.
+  BddVec contra = clauses;
+  contra.push_back(~cnf);
+  VALIDATE(mgr.conjoin(contra).isZero());
+  VALIDATE(mgr.checkMem());
+} // testConjoin
+
+
+//      Function : testQuantify
+//      Abstract : Quantification over a cube compared with expanding
+//      each variable by hand.
+void
+testQuantify()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Quantify Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  const int N = 12;
+  BddMgr mgr(N);
+  BddVec x;
+  for (int idx = 1; idx <= N; ++idx) {
+    x.push_back(mgr.getLit(idx));
+  } // for
+  Bdd F = x[0]*x[5] + (x[1]^x[7]) + ~x[2]*x[9]*x[11] + x[3]*~x[4];
+  Bdd G = (x[0] + x[6]) * (x[5]^x[10]) + x[8]*~x[11]*x[2];
+  Bdd cube = x[0] * x[2] * x[5] * x[10];
+
+  Bdd E = F;
+  Bdd A = F;
+  Bdd U = F;
+  for (int idx : {0, 2, 5, 10}) {
+    E = E/x[idx] + E/~x[idx];
+    A = A/x[idx] * A/~x[idx];
+    U = U/x[idx] ^ U/~x[idx];
+  } // for each variable
+  VALIDATE(F.exists(cube) == E);
+  VALIDATE(mgr.exists(F, cube) == E);
+  VALIDATE(F.forall(cube) == A);
+  VALIDATE(mgr.forall(F, cube) == A);
+  VALIDATE(F.unique(cube) == U);
+  VALIDATE(mgr.unique(F, cube) == U);
+  VALIDATE(F.exists(mgr.getOne()) == F);
+  VALIDATE(F.forall(mgr.getOne()) == F);
+  VALIDATE(F.unique(mgr.getOne()) == F);
+  VALIDATE(mgr.getOne().exists(cube).isOne());
+  VALIDATE(mgr.getZero().forall(cube).isZero());
+  VALIDATE(mgr.getOne().unique(cube).isZero());
+  VALIDATE(x[3].unique(x[3]).isOne());
+  VALIDATE(x[3].unique(x[4]).isZero());
+  VALIDATE((x[3] * x[4]).unique(x[3] * x[4]).isOne());
+  VALIDATE(F.exists(x[0]) == F/x[0] + F/~x[0]);
+  VALIDATE(F.exists(x[3] * x[4]).isOne());
+
+  for (BddOp op : {AND, NAND, OR, NOR, XOR, XNOR, IMPL}) {
+    Bdd R = mgr.applyExists(F, G, cube, op);
+    VALIDATE(R == mgr.exists(mgr.applyExists(F, G, mgr.getOne(), op), cube));
+    VALIDATE(R == mgr.applyExists(F, G, cube, op));
+  } // for each op
+  VALIDATE(mgr.applyExists(F, G, cube, AND) == mgr.andExists(F, G, cube));
+  VALIDATE(mgr.applyExists(F, G, mgr.getOne(), XOR) == (F ^ G));
+  VALIDATE(mgr.applyExists(F, G, mgr.getOne(), IMPL) == F.implies(G));
+  VALIDATE(mgr.applyExists(F, F, cube, XOR).isZero());
+  VALIDATE(mgr.applyExists(F, ~F, cube, XOR).isOne());
+  VALIDATE(mgr.applyExists(mgr.getOne(), G, cube, XOR) == (~G).exists(cube));
+  VALIDATE(!mgr.exists(Bdd(), cube).valid());
+  VALIDATE(!mgr.applyExists(F, Bdd(), cube, XOR).valid());
+
+  // Each result survives gc and reordering.
+  mgr.gc(true);
+  mgr.reorder();
+  VALIDATE(F.exists(cube) == E);
+  VALIDATE(F.forall(cube) == A);
+  VALIDATE(F.unique(cube) == U);
+  VALIDATE(mgr.checkMem());
+} // testQuantify
+
+
+//      Function : testVectorCompose
+//      Abstract : Simultaneous substitution compared with chains of
+//      compose().
+void
+testVectorCompose()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Vector Compose Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  const int N = 12;
+  BddMgr mgr(N + 1);
+  BddVec x;
+  for (int idx = 1; idx <= N; ++idx) {
+    x.push_back(mgr.getLit(idx));
+  } // for
+  Bdd t = mgr.getLit(N + 1);
+  Bdd F = x[0]*x[5] + (x[1]^x[7]) + ~x[2]*x[9]*x[11] + x[3]*~x[4];
+  Bdd G = (x[8] + x[6]) * (x[11]^x[10]);
+  Bdd H = x[9] ^ ~x[11];
+
+  // Replacements free of the variables replaced.
+  Bdd C = F.compose(1, G).compose(3, H).compose(6, x[10]);
+  VALIDATE(mgr.vectorCompose(F, {{1, G}, {3, H}, {6, x[10]}}) == C);
+
+  // A swap needs a chain through a spare variable.
+  Bdd S = F.compose(1, t).compose(2, x[0]).compose(N + 1, x[1]);
+  VALIDATE(mgr.vectorCompose(F, {{1, x[1]}, {2, x[0]}}) == S);
+  VALIDATE(mgr.vectorCompose(S, {{1, x[1]}, {2, x[0]}}) == F);
+
+  VALIDATE(mgr.vectorCompose(F, {}) == F);
+  VALIDATE(mgr.vectorCompose(F, {{1, x[0]}, {8, x[7]}}) == F);
+  VALIDATE(mgr.vectorCompose(F, {{N + 7, G}}) == F);
+  VALIDATE(mgr.vectorCompose(F, {{9, G}}) == F);
+  VALIDATE(mgr.vectorCompose(F, {{1, mgr.getOne()}, {6, mgr.getZero()}})
+           == F / (x[0] * ~x[5]));
+  VALIDATE(mgr.vectorCompose(~F, {{1, G}, {3, H}, {6, x[10]}}) == ~C);
+  BddVec both = mgr.vectorCompose(BddVec{F, ~F, Bdd()},
+                                  {{1, x[1]}, {2, x[0]}});
+  VALIDATE(both[0] == S && both[1] == ~S && !both[2].valid());
+  VALIDATE(!mgr.vectorCompose(F, {{1, Bdd()}}).valid());
+  VALIDATE(!mgr.vectorCompose(Bdd(), {{1, G}}).valid());
+
+  mgr.gc(true);
+  mgr.reorder();
+  VALIDATE(mgr.vectorCompose(F, {{1, G}, {3, H}, {6, x[10]}}) == C);
+  VALIDATE(mgr.vectorCompose(F, {{1, x[1]}, {2, x[0]}}) == S);
+  VALIDATE(mgr.checkMem());
+
+  mgr.gc(true);
+  mgr.setMaxNodes(mgr.nodesAllocd() + 4);
+  VALIDATE(!mgr.vectorCompose(F, {{1, G}, {3, H}, {6, x[10]}}).valid());
+  VALIDATE(mgr.checkMem());
+  mgr.setMaxNodes(1<<20);
+  VALIDATE(mgr.vectorCompose(F, {{1, G}, {3, H}, {6, x[10]}}) == C);
+  VALIDATE(mgr.checkMem());
+
+  // Only the root of a function is referenced, so the gc before a
+  // retry may compact its other nodes to new ids. Garbage is made
+  // before and after the function so that it spans the banks that
+  // compaction releases.
+  const int M = 26;
+  BddMgr big(M);
+  big.setAutoCompact(true);
+  BddVec y;
+  for (int idx = 1; idx <= M; ++idx) {
+    y.push_back(big.getLit(idx));
+  } // for
+  unsigned seed = 1;
+  auto junk = [&big, &y, &seed](int numCubes) {
+    Bdd g = big.getZero();
+    for (int cube = 0; cube < numCubes; ++cube) {
+      Bdd c = big.getOne();
+      for (int lit = 0; lit < 6; ++lit) {
+        seed = seed * 1103515245 + 12345;
+        Bdd v = y[(seed >> 16) % M];
+        c *= (seed >> 8) & 1 ? v : ~v;
+      } // for each literal
+      g += c;
+    } // for each cube
+    return g;
+  }; // junk
+  junk(600);
+  Bdd J = junk(600);
+  junk(600);
+  size_t before = big.nodesAllocd();
+  big.setMaxNodes(before + 4);
+  Bdd R = big.vectorCompose(J, {{M - 2, y[M - 1]}});
+  big.setMaxNodes(1<<20);
+  VALIDATE(big.nodesAllocd() < before);
+  VALIDATE(R == J.compose(M - 2, y[M - 1]));
+  BddVarVec perm(M + 1);
+  for (int idx = 1; idx <= M; ++idx) {
+    perm[idx] = idx;
+  } // for
+  std::swap(perm[M - 2], perm[M - 1]);
+  junk(600);
+  before = big.nodesAllocd();
+  big.setMaxNodes(before + 4);
+  R = big.permute(J, perm);
+  big.setMaxNodes(1<<20);
+  VALIDATE(R == big.swapVariables(J, {M - 2}, {M - 1}));
+  VALIDATE(big.checkMem());
+} // testVectorCompose
+
+
+//      Function : testPermute
+//      Abstract : Renaming and swapping variables.
+void
+testPermute()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Permute Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  // Current state variables 1-6 and next state variables 7-12.
+  const BddVar N = 6;
+  BddMgr mgr(2 * N);
+  BddVec x;
+  BddVec y;
+  BddVarVec xs;
+  BddVarVec ys;
+  for (BddVar idx = 1; idx <= N; ++idx) {
+    x.push_back(mgr.getLit(idx));
+    xs.push_back(idx);
+  } // for
+  for (BddVar idx = N + 1; idx <= 2 * N; ++idx) {
+    y.push_back(mgr.getLit(idx));
+    ys.push_back(idx);
+  } // for
+  Bdd F = x[0]*x[3] + (x[1]^x[5]) + ~x[2]*x[4];
+  Bdd Fy = y[0]*y[3] + (y[1]^y[5]) + ~y[2]*y[4];
+  Bdd T = (y[0].xnor2(x[1])) * (y[1].xnor2(x[0]^x[2])) * (y[4] + x[5]);
+  Bdd Tswap = (x[0].xnor2(y[1])) * (x[1].xnor2(y[0]^y[2])) * (x[4] + y[5]);
+
+  // Shifting to the next state variables keeps the order.
+  BddVarVec shift(N + 1);
+  for (BddVar idx = 1; idx <= N; ++idx) {
+    shift[idx] = idx + N;
+  } // for
+  VALIDATE(mgr.permute(F, shift) == Fy);
+  VALIDATE(mgr.permute(~F, shift) == ~Fy);
+  VALIDATE(mgr.permute(F, shift).countNodes() == F.countNodes());
+  VALIDATE(mgr.swapVariables(F, xs, ys) == Fy);
+  VALIDATE(mgr.swapVariables(Fy, xs, ys) == F);
+  VALIDATE(mgr.swapVariables(T, xs, ys) == Tswap);
+  VALIDATE(mgr.swapVariables(Tswap, ys, xs) == T);
+
+  // A rotation reverses part of the order.
+  BddVarVec rotate{0, 2, 3, 1};
+  Bdd R = x[1]*x[3] + (x[2]^x[5]) + ~x[0]*x[4];
+  VALIDATE(mgr.permute(F, rotate) == R);
+  VALIDATE(mgr.permute(F, BddVarVec()) == F);
+  VALIDATE(mgr.permute(F, BddVarVec{0, 1, 2}) == F);
+
+  // Renaming to a variable not yet created adds it.
+  BddVarVec fresh{0, 2 * N + 1};
+  Bdd G = mgr.permute(F, fresh);
+  VALIDATE(G == F.compose(1, mgr.getLit(2 * N + 1)));
+  VALIDATE(mgr.varsCreated() == 2 * N + 1);
+
+  mgr.gc(true);
+  mgr.reorder();
+  VALIDATE(mgr.permute(F, shift) == Fy);
+  VALIDATE(mgr.swapVariables(T, xs, ys) == Tswap);
+  VALIDATE(mgr.checkMem());
+} // testPermute
+
+
+//      Function : testImage
+//      Abstract : Image and preimage with a partitioned transition
+//      relation compared with the monolithic relation.
+void
+testImage()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Image Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  // A 4-bit counter with an enable. Current and next state variables
+  // are interleaved and the enable is last.
+  const BddVar N = 4;
+  BddMgr mgr(2 * N + 1);
+  BddVec x;
+  BddVec y;
+  BddVarVec xs;
+  BddVarVec ys;
+  for (BddVar bit = 0; bit < N; ++bit) {
+    xs.push_back(2 * bit + 1);
+    ys.push_back(2 * bit + 2);
+    x.push_back(mgr.getLit(xs.back()));
+    y.push_back(mgr.getLit(ys.back()));
+  } // for
+  Bdd e = mgr.getLit(2 * N + 1);
+  BddVec parts;
+  Bdd carry = e;
+  for (BddVar bit = 0; bit < N; ++bit) {
+    parts.push_back(y[bit].xnor2(x[bit] ^ carry));
+    carry *= x[bit];
+  } // for
+  auto state = [&x, &mgr](unsigned val) {
+    Bdd s = mgr.getOne();
+    for (BddVar bit = 0; bit < N; ++bit) {
+      s *= (val >> bit) & 1 ? x[bit] : ~x[bit];
+    } // for
+    return s;
+  }; // state
+
+  Bdd T = mgr.conjoin(parts);
+  Bdd xCube = mgr.getOne();
+  Bdd yCube = mgr.getOne();
+  for (BddVar bit = 0; bit < N; ++bit) {
+    xCube *= x[bit];
+    yCube *= y[bit];
+  } // for
+  auto monoImage = [&](const Bdd &S) {
+    return mgr.swapVariables(mgr.andExists(S, T, xCube * e), xs, ys);
+  }; // monoImage
+  auto monoPreimage = [&](const Bdd &S) {
+    return mgr.andExists(mgr.swapVariables(S, xs, ys), T, yCube * e);
+  }; // monoPreimage
+
+  for (size_t clusterSz : {size_t(1), size_t(20), BddImage::DFLT_CLUSTER_SZ}) {
+    BddImage img(mgr, parts, xs, ys, clusterSz);
+    VALIDATE(img.image(state(0)) == state(0) + state(1));
+    VALIDATE(img.image(state(15)) == state(15) + state(0));
+    VALIDATE(img.preimage(state(1)) == state(0) + state(1));
+    VALIDATE(img.image(mgr.getZero()).isZero());
+    VALIDATE(img.image(mgr.getOne()).isOne());
+    for (unsigned val = 0; val < 16; val += 3) {
+      Bdd S = state(val) + state((val * 7) % 16) + x[1] * ~x[3];
+      VALIDATE(img.image(S) == monoImage(S));
+      VALIDATE(img.preimage(S) == monoPreimage(S));
+    } // for each state set
+    VALIDATE(img.numClusters() >= 1 && img.numClusters() <= N);
+  } // for each cluster bound
+
+  BddImage single(mgr, parts, xs, ys, 1);
+  BddImage whole(mgr, parts, xs, ys, 1<<20);
+  VALIDATE(single.numClusters() == N);
+  VALIDATE(whole.numClusters() == 1);
+  VALIDATE(whole.clusterNodes() == T.countNodes());
+
+  BddImage none(mgr, BddVec(), xs, ys);
+  VALIDATE(none.image(state(5)).isOne());
+  VALIDATE(none.numClusters() == 0);
+  VALIDATE(!single.image(Bdd()).valid());
+  VALIDATE(mgr.checkMem());
+} // testImage
+
+
+//      Function : testReach
+//      Abstract : Forward and backward reachability to a fixpoint.
+void
+testReach()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Reachability Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  // A 4-bit counter with an enable whose top bit holds its value.
+  const BddVar N = 4;
+  BddMgr mgr(2 * N + 1);
+  BddVec x;
+  BddVec y;
+  BddVarVec xs;
+  BddVarVec ys;
+  for (BddVar bit = 0; bit < N; ++bit) {
+    xs.push_back(2 * bit + 1);
+    ys.push_back(2 * bit + 2);
+    x.push_back(mgr.getLit(xs.back()));
+    y.push_back(mgr.getLit(ys.back()));
+  } // for
+  Bdd e = mgr.getLit(2 * N + 1);
+  BddVec parts;
+  Bdd carry = e;
+  for (BddVar bit = 0; bit + 1 < N; ++bit) {
+    parts.push_back(y[bit].xnor2(x[bit] ^ carry));
+    carry *= x[bit];
+  } // for
+  parts.push_back(y[N - 1].xnor2(x[N - 1]));
+  auto state = [&x, &mgr](unsigned val) {
+    Bdd s = mgr.getOne();
+    for (BddVar bit = 0; bit < N; ++bit) {
+      s *= (val >> bit) & 1 ? x[bit] : ~x[bit];
+    } // for
+    return s;
+  }; // state
+
+  BddImage img(mgr, parts, xs, ys, 1);
+  BddReachSteps steps;
+  Bdd lower = img.reach(state(0), BddReachOpts(), &steps);
+  VALIDATE(lower == ~x[N - 1]);
+  VALIDATE(steps.size() == 8);
+  VALIDATE(steps.back().reachedNodes == lower.countNodes());
+  VALIDATE(steps.front().frontierNodes == state(0).countNodes());
+  bool peaksOk = true;
+  for (const auto &step : steps) {
+    peaksOk = peaksOk && step.peakNodes >= step.reachedNodes;
+    peaksOk = peaksOk && step.secs >= 0.0;
+  } // for each step
+  VALIDATE(peaksOk);
+
+  // The peak is kept after the nodes are freed.
+  mgr.gc(true);
+  mgr.resetPeakNodes();
+  const size_t live = mgr.nodesAllocd();
+  VALIDATE(mgr.peakNodes() == live);
+  {
+    Bdd parity = mgr.getZero();
+    for (const auto &lit : x) {
+      parity ^= lit;
+    } // for
+    VALIDATE(mgr.peakNodes() > live);
+  }
+  mgr.gc(true);
+  VALIDATE(mgr.nodesAllocd() == live);
+  VALIDATE(mgr.peakNodes() > live);
+
+  // Each iteration adds one state. Taking the image of everything
+  // reached instead of the frontier gives the same set.
+  Bdd naive = state(0);
+  for (Bdd prev; naive != prev; ) {
+    prev = naive;
+    naive += img.image(naive);
+  } // while
+  VALIDATE(naive == lower);
+
+  BddReachOpts opts;
+  opts.backward = true;
+  steps.clear();
+  VALIDATE(img.reach(state(3), opts, &steps) == ~x[N - 1]);
+  VALIDATE(steps.size() == 8);
+  VALIDATE(img.reach(state(9), opts) == x[N - 1]);
+
+  opts = BddReachOpts();
+  opts.maxIters = 3;
+  VALIDATE(img.reach(state(0), opts) == state(0) + state(1) + state(2)
+           + state(3));
+  opts.maxIters = 0;
+  opts.gc = true;
+  opts.reorder = true;
+  VALIDATE(img.reach(state(8), opts) == x[N - 1]);
+
+  VALIDATE(img.reach(mgr.getZero()).isZero());
+  VALIDATE(img.reach(mgr.getOne()).isOne());
+  VALIDATE(!img.reach(Bdd()).valid());
+  VALIDATE(mgr.checkMem());
+} // testReach
+
+
+//      Function : testSatCount
+//      Abstract : Counting satisfying assignments in each precision.
+void
+testSatCount()
+{
+  cout << "\n----------------------------------------------------------------"
+       << endl;
+  cout << "Sat Count Tests:" << endl;
+  cout << "----------------------------------------------------------------"
+       << endl;
+  const BddVar N = 8;
+  BddMgr mgr(N);
+  BddVec x;
+  for (BddVar idx = 1; idx <= N; ++idx) {
+    x.push_back(mgr.getLit(idx));
+  } // for
+  Bdd zero = mgr.getZero();
+  Bdd one = mgr.getOne();
+
+  VALIDATE(zero.satCount(N) == 0.0);
+  VALIDATE(one.satCount(N) == 256.0);
+  VALIDATE(one.satCount(0) == 1.0);
+  VALIDATE(x[0].satCount(3) == 4.0);
+  VALIDATE((~x[0]).satCount128(3) == 4);
+  VALIDATE((x[0] + x[1]).satCount(2) == 3.0);
+  VALIDATE((x[0] + x[1]).satCountStr(10) == "768");
+  VALIDATE((x[2] * x[6]).satCount(N) == 64.0);
+  VALIDATE((x[2] * ~x[6]).satCount(2) == 1.0);
+  // Fewer variables than the support count as zero in every variant.
+  Bdd cube3 = x[1] * x[2] * x[3];
+  VALIDATE(cube3.satCount(1) == 0.0);
+  VALIDATE(cube3.satCount128(1) == 0);
+  VALIDATE(cube3.satCountStr(1) == "0");
+  VALIDATE(mgr.satCountStr(BddVec{x[0], cube3}, 2)
+           == std::vector<std::string>({"0", "0"}));
+
+  Bdd parity = zero;
+  for (const auto &lit : x) {
+    parity ^= lit;
+  } // for
+  VALIDATE(parity.satCount(N) == 128.0);
+  VALIDATE((~parity).satCount128(N) == 128);
+  VALIDATE((parity * x[3]).satCountStr(N) == "64");
+
+  // Compare with enumerating the assignments.
+  Bdd F = x[0]*x[3] + (x[1]^x[5]) + ~x[2]*x[4]*x[7] + (x[6] ^ x[7]) * x[2];
+  unsigned minterms = 0;
+  for (unsigned val = 0; val < (1u << N); ++val) {
+    Bdd m = F;
+    for (BddVar bit = 0; bit < N; ++bit) {
+      m = m.restrict((val >> bit) & 1 ? x[bit] : ~x[bit]);
+    } // for
+    minterms += m.isOne();
+  } // for
+  VALIDATE(F.satCount(N) == double(minterms));
+  VALIDATE((~F).satCount128(N) == (1u << N) - minterms);
+  VALIDATE(F.satCountStr(N) == std::to_string(minterms));
+
+  // Shared counting gives the same counts as counting each alone.
+  BddVec fs = {F, ~F, parity, F * parity, zero, Bdd(), one};
+  auto dbls = mgr.satCount(fs, N);
+  auto ints = mgr.satCount128(fs, N);
+  auto strs = mgr.satCountStr(fs, N);
+  bool sharedOk = dbls.size() == fs.size() && strs.size() == fs.size();
+  for (size_t i = 0; sharedOk && i < fs.size(); ++i) {
+    double alone = fs[i].valid() ? fs[i].satCount(N) : 0.0;
+    sharedOk = (dbls[i] == alone && double(ints[i]) == alone
+                && strs[i] == std::to_string(size_t(alone)));
+  } // for
+  VALIDATE(sharedOk);
+  VALIDATE(dbls[0] + dbls[1] == 256.0);
+
+  // Reordering changes no count.
+  mgr.reorder();
+  VALIDATE(F.satCount(N) == double(minterms));
+  VALIDATE(parity.satCountStr(N) == "128");
+
+  // Counts beyond 64 and 128 bits.
+  const BddCount128 two127 = BddCount128(1) << 127;
+  VALIDATE(one.satCount128(127) == two127);
+  VALIDATE(x[0].satCount128(128) == two127);
+  VALIDATE(one.satCount128(128) == ~BddCount128(0));
+  VALIDATE(one.satCount128(500) == ~BddCount128(0));
+  VALIDATE(one.satCountStr(64) == "18446744073709551616");
+  VALIDATE(one.satCountStr(200)
+           == "1606938044258990275541962092341162602522202993782792835301376");
+  VALIDATE((~x[0]).satCountStr(201)
+           == "1606938044258990275541962092341162602522202993782792835301376");
+  VALIDATE(x[0].satCount(1001) == std::ldexp(1.0, 1000));
+  VALIDATE(zero.satCountStr(300) == "0");
+  VALIDATE(mgr.checkMem());
+} // testSatCount
@@ -0,0 +1,137 @@
+//
+//      File     : NodeArena.h
+//      Abstract : Reserved address range for node storage.
+//
+
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#define NODEARENA_MMAP
+#endif
+
+namespace abide {
+
+//      Class    : NodeArena
+//      Abstract : An array of T large enough to hold one element for
+//      every node id, made by reserving address space rather than
+//      allocating memory. The OS supplies zeroed pages when they are
+//      first touched, so the array grows without being copied. Pages
+//      given back by release() read as zero if touched again. With
+//      huge set, the range is aligned to and advised for transparent
+//      huge pages. Where mmap() is not available, reserve() fails and
+//      the caller is expected to use the heap.
+template <typename T>
+class NodeArena {
+ public:
+  NodeArena() = default;
+  ~NodeArena() { unreserve(); };
+
+  NodeArena(const NodeArena &) = delete; // Copy CTOR
+  NodeArena &operator=(const NodeArena &) = delete; // Copy assignment
+  NodeArena(NodeArena &&) = delete; // Move CTOR
+  NodeArena &operator=(NodeArena &&) = delete; // Move assignment
+
+  bool reserve(size_t num, bool huge);
+  void unreserve();
+  void release(size_t idx, size_t num);
+
+  bool valid() const { return _base != nullptr; };
+  size_t size() const { return _num; };
+  T *at(size_t idx) const { return _base + idx; };
+  bool contains(const T *p) const { return p >= _base && p < _base + _num; };
+
+ private:
+  static const size_t HUGE_PAGE_SZ = (1<<21);
+
+  void *_map = nullptr;
+  size_t _mapBytes = 0;
+  T *_base = nullptr;
+  size_t _num = 0;
+}; // NodeArena
+
+
+//      Function : NodeArena::reserve
+//      Abstract : Reserve room for num elements. Returns false if the
+//      address space could not be had.
+template <typename T>
+bool
+NodeArena<T>::reserve([[maybe_unused]] size_t num,
+                      [[maybe_unused]] bool huge)
+{
+#ifdef NODEARENA_MMAP
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif
+  size_t bytes = num * sizeof(T);
+  size_t slack = huge ? HUGE_PAGE_SZ : 0;
+  void *map = mmap(nullptr, bytes + slack, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (map == MAP_FAILED) {
+    return false;
+  } // if
+
+  uintptr_t addr = reinterpret_cast<uintptr_t>(map);
+  if (huge) {
+    addr = (addr + HUGE_PAGE_SZ - 1) & ~(HUGE_PAGE_SZ - 1);
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void *>(addr), bytes, MADV_HUGEPAGE);
+#endif
+  } // if
+  _map = map;
+  _mapBytes = bytes + slack;
+  _base = reinterpret_cast<T *>(addr);
+  _num = num;
+  return true;
+#else
+  return false;
+#endif
+} // NodeArena::reserve
+
+
+//      Function : NodeArena::unreserve
+//      Abstract : Give back the whole range.
+template <typename T>
+void
+NodeArena<T>::unreserve()
+{
+#ifdef NODEARENA_MMAP
+  if (_map) {
+    munmap(_map, _mapBytes);
+  } // if
+#endif
+  _map = nullptr;
+  _mapBytes = 0;
+  _base = nullptr;
+  _num = 0;
+} // NodeArena::unreserve
+
+
+//      Function : NodeArena::release
+//      Abstract : Give the pages wholly inside elements [idx, idx+num)
+//      back to the OS.
+template <typename T>
+void
+NodeArena<T>::release([[maybe_unused]] size_t idx,
+                      [[maybe_unused]] size_t num)
+{
+#ifdef NODEARENA_MMAP
+  const uintptr_t pageSz = sysconf(_SC_PAGESIZE);
+  uintptr_t start = reinterpret_cast<uintptr_t>(_base + idx);
+  uintptr_t end = reinterpret_cast<uintptr_t>(_base + idx + num);
+  start = (start + pageSz - 1) & ~(pageSz - 1);
+  end &= ~(pageSz - 1);
+  if (start < end) {
+    madvise(reinterpret_cast<void *>(start), end - start, MADV_DONTNEED);
+  } // if
+#endif
+} // NodeArena::release
+
+} // namespace abide
+
+#endif // NODEARENA_H
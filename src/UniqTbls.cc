@@ -4,32 +4,75 @@
 //
 
 #include <BddImpl.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 
 namespace abide {
 
 namespace {
-const size_t UNIQ_LG_SZ = 12;
+// Tables start small and grow with their level, so a manager with
+// many sparsely used variables costs little more per level than the
+// UniqTbl itself. After gc a table is shrunk to fit its nodes, down
+// to this size.
+const size_t UNIQ_LG_SZ = 4;
 const size_t UNIQ_INIT_SZ = 1 << UNIQ_LG_SZ;
 const size_t UNIQ_LD_FACTOR = 1;
 const size_t UNIQ_LG_GROWTH_FACTOR = 2;
+
+// Open addressing keeps the load at or below 1/2 and doubles.
+const size_t UNIQ_OPEN_LD_NUM = 1;
+const size_t UNIQ_OPEN_LD_DEN = 2;
+const size_t UNIQ_OPEN_LG_GROWTH_FACTOR = 1;
+
+// A table is only resized during a parallel operation once every
+// worker has paused, so inserts may take it past the usual load up to
+// these limits. Beyond them the workers pause and it is resized.
+const size_t UNIQ_SHARED_LD_NUM = 3;
+const size_t UNIQ_SHARED_LD_DEN = 4;
+const size_t UNIQ_SHARED_LD_FACTOR = 2 * UNIQ_LD_FACTOR;
+
+// Slots of the old array moved per findOrAdd() during an incremental
+// resize. Doubling at a load of 1/2 leaves at least half the old size
+// in insertions before the next resize, so anything over 2 finishes
+// in time.
+const size_t UNIQ_MIGRATE_STEP = 16;
+
+// Multiplicative hash. Linear probing needs better mixing than
+// hash2() provides.
+inline uint32_t uniqHash(const BDD hi, const BDD lo) {
+  uint64_t key = (static_cast<uint64_t>(hi) << 32) | lo;
+  return (key * 0x9E3779B97F4A7C15ULL) >> 32;
+} // uniqHash
 } // anonymous namespace
 
 //      Function : UniqTbl::UniqTbl
-//      Abstract : Constructor.
-UniqTbl::UniqTbl() :
+//      Abstract : Constructor. The table is allocated on the first
+//      insertion.
+UniqTbl::UniqTbl(const bool chained) :
   _tbl(nullptr),
-  _size(UNIQ_INIT_SZ),
-  _mask(_size-1),
+  _old(nullptr),
+  _oldSize(0),
+  _migrated(0),
+  _heads(nullptr),
+  _size(0),
+  _mask(0),
   _numNodes(0),
+  _chained(chained),
   _processed(false)
 {
-  _tbl = new BDD[_size];
-  for (size_t idx = 0; idx < _size; ++idx) {
-    _tbl[idx] = 0;
-  } // zero-out mem
 } // UniqTbl::UniqTbl
 
 
+//      Function : UniqTbl::size
+//      Abstract : Number of slots visited by getHash().
+size_t
+UniqTbl::size() const
+{
+  return _size + _oldSize - _migrated;
+} // UniqTbl::size
+
+
 //      Function : UniqTbl::findOrAdd
 //      Abstract : Find or add a node in this table.
 BDD
@@ -37,15 +80,389 @@ UniqTbl::findOrAdd(BddImpl &impl,
                    const int index,
                    const BDD hi,
                    const BDD lo)
+{
+  if (_chained) {
+    return findOrAddChained(impl, index, hi, lo);
+  } // if chained
+
+  uint32_t hash = uniqHash(hi, lo);
+
+  if (!_tbl) {
+    allocTbl(UNIQ_INIT_SZ);
+  } // if first node
+
+  if (_old) {
+    migrate(UNIQ_MIGRATE_STEP);
+  } // if resizing
+
+  size_t hdx = hash & _mask;
+
+  impl._cacheStats.incUniqAccess();
+
+  for (; _tbl[hdx]._f; hdx = (hdx + 1) & _mask) {
+    impl._cacheStats.incUniqChain();
+    if (_tbl[hdx]._hash == hash) {
+      BDD cur = _tbl[hdx]._f;
+      BddNode &n = impl.getNode(cur);
+      if (n.getHi() == hi && n.getLo() == lo) {
+        impl._cacheStats.incUniqHit();
+        return cur;
+      } // if found
+    } // if fingerprint matches
+  } // for occupied slots
+
+  if (_old) {
+    if (BDD cur = findOld(impl, hash, hi, lo);
+        cur) {
+      impl._cacheStats.incUniqHit();
+      return cur;
+    } // if found
+  } // if resizing
+
+  impl._cacheStats.incUniqMiss();
+  BDD rtn = impl.allocateNode(hi);
+  if (rtn) {
+    BddNode &n = impl.getNode(rtn);
+    n.setIndex(index);
+    n.setHi(hi);
+    n.setLo(lo);
+    _tbl[hdx]._f = rtn;
+    _tbl[hdx]._hash = hash;
+    ++_numNodes;
+
+    if (_numNodes * UNIQ_OPEN_LD_DEN > _size * UNIQ_OPEN_LD_NUM) {
+      resize(impl);
+    } // if load too high
+  } // if (rtn) ...
+
+  return rtn;
+} // UniqTbl::findOrAdd
+
+
+//      Function : UniqTbl::findOrAddShared
+//      Abstract : findOrAdd() for a parallel operation. A new node is
+//      taken from spare and published by swapping it into an empty
+//      slot. If another thread fills the slot first, probing goes on
+//      from there. The table cannot be resized here, so 0 is returned
+//      once it is 3/4 full, as it is when no node is left.
+BDD
+UniqTbl::findOrAddShared(BddImpl &impl,
+                         BDDVec &spare,
+                         const int index,
+                         const BDD hi,
+                         const BDD lo)
+{
+  if (_chained) {
+    return findOrAddSharedChained(impl, spare, index, hi, lo);
+  } // if chained
+
+  const uint32_t hash = uniqHash(hi, lo);
+  BDD mine = 0;
+
+  for (size_t hdx = hash & _mask; ; hdx = (hdx + 1) & _mask) {
+    Slot cur;
+    __atomic_load(&_tbl[hdx], &cur, __ATOMIC_ACQUIRE);
+    while (!cur._f) {
+      if (!mine) {
+        if (__atomic_load_n(&_numNodes, __ATOMIC_RELAXED) * UNIQ_SHARED_LD_DEN
+            >= _size * UNIQ_SHARED_LD_NUM) {
+          return 0;
+        } // if full
+        mine = impl.allocateShared(spare);
+        if (!mine) {
+          return 0;
+        } // if out of nodes
+        BddNode &n = impl.getNode(mine);
+        n.setHi(hi);
+        n.setLo(lo);
+        n.publishIndex(index);
+      } // if no node yet
+      Slot nu{mine, hash};
+      if (__atomic_compare_exchange(&_tbl[hdx], &cur, &nu, false,
+                                    __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+        __atomic_fetch_add(&_numNodes, 1, __ATOMIC_RELAXED);
+        return mine;
+      } // if claimed
+    } // while empty
+
+    if (cur._hash == hash) {
+      BddNode &n = impl.getNode(cur._f);
+      if (n.getHi() == hi && n.getLo() == lo) {
+        if (mine) {
+          // Not cleared, as another worker may be reading its index.
+          spare.push_back(mine);
+        } // if lost the race
+        return cur._f;
+      } // if found
+    } // if fingerprint matches
+  } // for each slot
+} // UniqTbl::findOrAddShared
+
+
+//      Function : UniqTbl::prepareShared
+//      Abstract : Make the table ready for findOrAddShared(): allocated,
+//      with no resize in progress and within its usual load, 1/2 for
+//      open addressing. Returns true if it grew.
+bool
+UniqTbl::prepareShared(BddImpl &impl)
+{
+  bool grown = false;
+  if (!allocated()) {
+    allocTbl(UNIQ_INIT_SZ);
+  } // if first node
+  if (_chained
+      ? _numNodes > UNIQ_LD_FACTOR * _size
+      : _numNodes * UNIQ_OPEN_LD_DEN > _size * UNIQ_OPEN_LD_NUM) {
+    resize(impl);
+    grown = true;
+  } // if load too high
+  if (_old) {
+    migrate(_oldSize);
+  } // if resizing
+  return grown;
+} // UniqTbl::prepareShared
+
+
+//      Function : UniqTbl::prefetch
+//      Abstract : Start loading the slot or chain head where
+//      findOrAdd() will look for hi and lo.
+void
+UniqTbl::prefetch(const BDD hi, const BDD lo) const
+{
+  if (_tbl) {
+    abide::prefetch(&_tbl[uniqHash(hi, lo) & _mask]);
+  } else if (_heads) {
+    abide::prefetch(&_heads[hash2(hi, lo) & _mask]);
+  } // if allocated
+} // UniqTbl::prefetch
+
+
+//      Function : UniqTbl::resize
+//      Abstract : Resize the table to reduce the load. Only the
+//      stored hashes are needed, so no node is touched. With
+//      incremental resizing the slots are moved later by migrate().
+void
+UniqTbl::resize(BddImpl &impl)
+{
+  if (_chained) {
+    resizeChained(impl);
+    return;
+  } // if chained
+
+  Slot *oldTbl = _tbl;
+  size_t oldSize = _size;
+
+  if (_old) {
+    migrate(_oldSize);
+  } // if still resizing
+
+  allocTbl(_size << UNIQ_OPEN_LG_GROWTH_FACTOR);
+
+  if (impl._incrUniq) {
+    _old = oldTbl;
+    _oldSize = oldSize;
+    _migrated = 0;
+    return;
+  } // if incremental
+
+  for (size_t idx = 0; idx < oldSize; ++idx) {
+    if (oldTbl[idx]._f) {
+      putSlot(oldTbl[idx]._f, oldTbl[idx]._hash);
+    } // if used
+  } // for each slot
+
+  std::free(oldTbl);
+} // UniqTbl::resize
+
+
+//      Function : UniqTbl::migrate
+//      Abstract : Move up to numSlots slots of the old array into the
+//      new one. The old array is not changed until it is freed, so
+//      probing it stays valid while the move is in progress.
+void
+UniqTbl::migrate(const size_t numSlots)
+{
+  size_t end = std::min(_oldSize, _migrated + numSlots);
+  for (; _migrated < end; ++_migrated) {
+    if (_old[_migrated]._f) {
+      putSlot(_old[_migrated]._f, _old[_migrated]._hash);
+    } // if used
+  } // for each slot
+
+  if (_migrated == _oldSize) {
+    std::free(_old);
+    _old = nullptr;
+    _oldSize = 0;
+    _migrated = 0;
+  } // if done
+} // UniqTbl::migrate
+
+
+//      Function : UniqTbl::findOld
+//      Abstract : Look for a node in the old array.
+BDD
+UniqTbl::findOld(BddImpl &impl,
+                 const uint32_t hash,
+                 const BDD hi,
+                 const BDD lo) const
+{
+  size_t oldMask = _oldSize - 1;
+  for (size_t hdx = hash & oldMask; _old[hdx]._f; hdx = (hdx + 1) & oldMask) {
+    if (_old[hdx]._hash == hash) {
+      BddNode &n = impl.getNode(_old[hdx]._f);
+      if (n.getHi() == hi && n.getLo() == lo) {
+        return _old[hdx]._f;
+      } // if found
+    } // if fingerprint matches
+  } // for occupied slots
+
+  return 0;
+} // UniqTbl::findOld
+
+
+//      Function : UniqTbl::getHash
+//      Abstract : Get the node in this slot, or the first node in the
+//      chain with this hash index. Zero if the slot is empty. During
+//      an incremental resize, the slots of the old array not yet
+//      moved follow those of the new one.
+BDD UniqTbl::getHash(const size_t hdx) const
+{
+  if (_chained) {
+    return _heads[hdx];
+  } // if chained
+  if (hdx >= _size) {
+    return _old[_migrated + hdx - _size]._f;
+  } // if old slot
+  return _tbl[hdx]._f;
+}; // getHash
+
+
+//      Function : UniqTbl::putSlot
+//      Abstract : Place the node in the first free slot at or after
+//      its hash index.
+void
+UniqTbl::putSlot(const BDD f, const uint32_t hash)
+{
+  size_t hdx = hash & _mask;
+  while (_tbl[hdx]._f) {
+    hdx = (hdx + 1) & _mask;
+  } // while occupied
+  _tbl[hdx]._f = f;
+  _tbl[hdx]._hash = hash;
+} // UniqTbl::putSlot
+
+
+//      Function : UniqTbl::putHash
+//      Abstract : Add a node known not to be in the table.
+void
+UniqTbl::putHash(BddImpl &impl, const BDD f)
+{
+  BddNode &node = impl.getNode(f);
+  if (!allocated()) {
+    allocTbl(UNIQ_INIT_SZ);
+  } // if first node
+  if (_chained) {
+    putHash(impl, f, hash2(node.getHi(), node.getLo()) & _mask);
+    return;
+  } // if chained
+  putSlot(f, uniqHash(node.getHi(), node.getLo()));
+  ++_numNodes;
+  if (_numNodes * UNIQ_OPEN_LD_DEN > _size * UNIQ_OPEN_LD_NUM) {
+    resize(impl);
+  } // if load too high
+} // UniqTbl::putHash
+
+
+//      Function : UniqTbl::clear
+//      Abstract : Clear out the table while placing all the nodes
+//      in the given vector. The nodes are usually put back right
+//      away, so the table is shrunk to fit them. Otherwise, tables
+//      left large by an earlier peak make every later clear slow.
+void
+UniqTbl::clear(BddImpl &impl, BDDVec &nodes)
+{
+  if (_chained) {
+    clearChained(impl, nodes);
+    return;
+  } // if chained
+
+  nodes.reserve(nodes.size() + _numNodes);
+  for (size_t hdx = 0; hdx < size(); ++hdx) {
+    if (BDD f = getHash(hdx);
+        f) {
+      nodes.push_back(f);
+    } // if used
+  } // for each slot
+  std::free(_old);
+  _old = nullptr;
+  _oldSize = 0;
+  _migrated = 0;
+
+  size_t numNodes = _numNodes;
+  _numNodes = 0;
+  if (fitSize(std::max<size_t>(numNodes, 1)) < _size) {
+    shrink(numNodes);
+  } else if (_tbl) {
+    std::memset(static_cast<void *>(_tbl), 0, _size * sizeof(Slot));
+  } // if shrink
+} // UniqTbl::clear
+
+
+//      Function : UniqTbl::fitSize
+//      Abstract : The table size needed to hold numNodes nodes. Zero
+//      if there are none.
+size_t
+UniqTbl::fitSize(const size_t numNodes) const
+{
+  size_t rtn = numNodes ? UNIQ_INIT_SZ : 0;
+  if (_chained) {
+    while (numNodes > UNIQ_LD_FACTOR * rtn) {
+      rtn <<= UNIQ_LG_GROWTH_FACTOR;
+    } // while
+    return rtn;
+  } // if chained
+  while (numNodes * UNIQ_OPEN_LD_DEN > rtn * UNIQ_OPEN_LD_NUM) {
+    rtn <<= UNIQ_OPEN_LG_GROWTH_FACTOR;
+  } // while
+  return rtn;
+} // UniqTbl::fitSize
+
+
+//      Function : UniqTbl::allocTbl
+//      Abstract : Replace the array with an empty one of the given
+//      size. The old array is either freed or owned by the caller.
+void
+UniqTbl::allocTbl(const size_t size)
+{
+  _size = size;
+  _mask = size ? size - 1 : 0;
+  if (_chained) {
+    _heads = size ? new BDD[size]() : nullptr;
+  } else {
+    _tbl = size ? allocSlots(size) : nullptr;
+  } // if
+} // UniqTbl::allocTbl
+
+
+//      Function : UniqTbl::findOrAddChained
+//      Abstract : findOrAdd() for a chained table.
+BDD
+UniqTbl::findOrAddChained(BddImpl &impl,
+                          const int index,
+                          const BDD hi,
+                          const BDD lo)
 {
   BDD rtn = 0;
+  if (!_heads) {
+    allocTbl(UNIQ_INIT_SZ);
+  } // if first node
   uint32_t hash = hash2(hi, lo) & _mask;
   BDD cur;
   BDD next;
 
   impl._cacheStats.incUniqAccess();
 
-  for (cur = getHash(hash); cur; cur = next) {
+  for (cur = _heads[hash]; cur; cur = next) {
     impl._cacheStats.incUniqChain();
     BddNode &n = impl.getNode(cur);
     // getHi() and getLo() should be OK as only uninverted nodes
@@ -55,13 +472,13 @@ UniqTbl::findOrAdd(BddImpl &impl,
       impl._cacheStats.incUniqHit();
       break;
     } else {
-      next = n.getNext();
+      next = impl.getNext(cur);
     } // if found
   } // for nodes in entry
 
   if (rtn == 0) {
     impl._cacheStats.incUniqMiss();
-    rtn = impl.allocateNode();
+    rtn = impl.allocateNode(hi);
 
     if (rtn) {
       BddNode &n = impl.getNode(rtn);
@@ -71,54 +488,95 @@ UniqTbl::findOrAdd(BddImpl &impl,
       putHash(impl, rtn, hash);
 
       if (_numNodes > UNIQ_LD_FACTOR * _size) {
-        resize(impl);
+        resizeChained(impl);
       } // if load average > 2
     }  /* if (rtn) ... */
   } // if not already created.
 
   return rtn;
-} // UniqTbl::findOrAdd
+} // UniqTbl::findOrAddChained
 
 
-//      Function : UniqTbl::resize
-//      Abstract : Resize the table to reduce the load average.
+//      Function : UniqTbl::findOrAddSharedChained
+//      Abstract : findOrAddShared() for a chained table. A new node is
+//      taken from spare and published by swapping it in as the head
+//      of its chain. If another thread changes the head first, the
+//      chain is searched again. The table cannot be resized here, so 0
+//      is returned once the load is twice the usual limit, as it is
+//      when no node is left.
+BDD
+UniqTbl::findOrAddSharedChained(BddImpl &impl,
+                                BDDVec &spare,
+                                const int index,
+                                const BDD hi,
+                                const BDD lo)
+{
+  const uint32_t hdx = hash2(hi, lo) & _mask;
+  BDD mine = 0;
+  BDD head = __atomic_load_n(&_heads[hdx], __ATOMIC_ACQUIRE);
+
+  while (true) {
+    for (BDD cur = head; cur; cur = impl.getNext(cur)) {
+      BddNode &n = impl.getNode(cur);
+      if (n.getHi() == hi && n.getLo() == lo) {
+        if (mine) {
+          // Not cleared, as another worker may be reading its index.
+          spare.push_back(mine);
+        } // if lost the race
+        return cur;
+      } // if found
+    } // for nodes in entry
+
+    if (!mine) {
+      if (__atomic_load_n(&_numNodes, __ATOMIC_RELAXED)
+          >= UNIQ_SHARED_LD_FACTOR * _size) {
+        return 0;
+      } // if full
+      mine = impl.allocateShared(spare);
+      if (!mine) {
+        return 0;
+      } // if out of nodes
+      BddNode &n = impl.getNode(mine);
+      n.setHi(hi);
+      n.setLo(lo);
+      n.publishIndex(index);
+    } // if no node yet
+    impl.setNext(mine, head);
+    if (__atomic_compare_exchange_n(&_heads[hdx], &head, mine, false,
+                                    __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)) {
+      __atomic_fetch_add(&_numNodes, 1, __ATOMIC_RELAXED);
+      return mine;
+    } // if claimed
+  } // while
+} // UniqTbl::findOrAddSharedChained
+
+
+//      Function : UniqTbl::resizeChained
+//      Abstract : Resize a chained table to reduce the load average.
 void
-UniqTbl::resize(BddImpl &impl)
+UniqTbl::resizeChained(BddImpl &impl)
 {
-  //cout << "Resizing utable." << endl;
-  BDD *oldTbl = _tbl;
+  BDD *oldHeads = _heads;
   size_t oldSize = _size;
 
-  _size = _size << UNIQ_LG_GROWTH_FACTOR;
-  _mask = _size - 1;
-  _tbl = new BDD[_size];
-
-  for (size_t idx = 0; idx < _size; ++idx) {
-    _tbl[idx] = 0;
-  } // zero-out mem
+  allocTbl(_size << UNIQ_LG_GROWTH_FACTOR);
 
   for (size_t idx = 0; idx < oldSize; ++idx) {
-    BDD f = oldTbl[idx];
+    BDD f = oldHeads[idx];
     BDD next;
 
     while (f) {
       next = impl.getNext(f);
-      putHash(impl, f);
+      BddNode &node = impl.getNode(f);
+      uint32_t hdx = hash2(node.getHi(), node.getLo()) & _mask;
+      impl.setNext(f, _heads[hdx]);
+      _heads[hdx] = f;
       f = next;
     } // while nodes in bin
   } // for each hash entry
 
-  delete [] oldTbl;
-} // UniqTbl::resize
-
-
-//      Function : UniqTbl::getHash
-//      Abstract : Get the first node in the collision chain for this
-//      hash index.
-BDD UniqTbl::getHash(const size_t hdx) const
-{
-  return _tbl[hdx];
-}; // getHash
+  delete [] oldHeads;
+} // UniqTbl::resizeChained
 
 
 //      Function : UniqTbl::putHash
@@ -129,44 +587,81 @@ UniqTbl::putHash(BddImpl &impl,
                  const BDD f,
                  const size_t hdx)
 {
-  BddNode &node = impl.getNode(f);
-  node.setNext(_tbl[hdx]);
-  _tbl[hdx] = f;
-  _numNodes++;
-} // UniqTbl::putHash
-
-
-//      Function : UniqTbl::putHash
-//      Abstract : Push this node onto the collision chain with the
-//      computes hash index.
-void
-UniqTbl::putHash(BddImpl &impl, const BDD f)
-{
-  BddNode &node = impl.getNode(f);
-  uint32_t hdx = hash2(node.getHi(), node.getLo()) & _mask;
-  node.setNext(_tbl[hdx]);
-  _tbl[hdx] = f;
+  impl.setNext(f, _heads[hdx]);
+  _heads[hdx] = f;
   _numNodes++;
 } // UniqTbl::putHash
 
 
-//      Function : UniqTbl::clear
-//      Abstract : Clear out the table while placing all the nodes
-//      in the given vector.
+//      Function : UniqTbl::clearChained
+//      Abstract : clear() for a chained table. The table is shrunk to
+//      fit the nodes as in the open-addressed version.
 void
-UniqTbl::clear(BddImpl &impl, BDDVec &nodes)
+UniqTbl::clearChained(BddImpl &impl, BDDVec &nodes)
 {
-  nodes.reserve(_numNodes);
+  nodes.reserve(nodes.size() + _numNodes);
   for (size_t hdx = 0; hdx < _size; ++hdx) {
-    BDD f = _tbl[hdx];
+    BDD f = _heads[hdx];
     while (f) {
       nodes.push_back(f);
       f = impl.getNext(f);
     } // while nodes to process
-    _tbl[hdx] = 0;
+    _heads[hdx] = 0;
   } // for each hash
+
+  size_t numNodes = _numNodes;
   _numNodes = 0;
-} // UniqTbl::clear
+  if (fitSize(std::max<size_t>(numNodes, 1)) < _size) {
+    shrink(numNodes);
+  } // if
+} // UniqTbl::clearChained
+
+
+//      Function : UniqTbl::shrink
+//      Abstract : Called on an empty table that is about to receive
+//      numNodes nodes. If a smaller array will hold them, the current
+//      one is replaced. With no nodes, the array is freed until the
+//      next insertion.
+void
+UniqTbl::shrink(const size_t numNodes)
+{
+  assert(_numNodes == 0);
+  if (size_t nuSize = fitSize(numNodes);
+      nuSize < _size) {
+    freeTbl();
+    allocTbl(nuSize);
+  } // if smaller
+} // UniqTbl::shrink
+
+
+//      Function : UniqTbl::reset
+//      Abstract : Forget every node in the table without visiting
+//      them. The array is kept for reuse. Used when all nodes are
+//      being freed at once.
+void
+UniqTbl::reset()
+{
+  std::free(_old);
+  _old = nullptr;
+  _oldSize = 0;
+  _migrated = 0;
+  if (_tbl) {
+    std::memset(static_cast<void *>(_tbl), 0, _size * sizeof(*_tbl));
+  } else if (_heads) {
+    std::fill(_heads, _heads + _size, 0);
+  } // if allocated
+  _numNodes = 0;
+  _processed = false;
+} // UniqTbl::reset
+
+
+//      Function : UniqTbls::resize
+//      Abstract : Add tables for new levels, of the manager's kind.
+void
+UniqTbls::resize(const size_t nuSize)
+{
+  _tables.resize(nuSize, UniqTbl(_impl._chainUniq));
+} // UniqTbls::resize
 
 
 //      Function : UniqTbls::~UniqTbls
@@ -10,48 +10,119 @@
 #include "BddNode.h"
 #include "CacheStats.h"
 #include "Defines.h"
+#include <cstdlib>
 
 namespace abide {
 
-//      Class    : UniqTbls
-//      Abstract : Unique table for nodes with the same index (level).
+//      Class    : UniqTbl
+//      Abstract : Unique table for nodes with the same index
+//      (level). By default, and with UNIQ_OPEN, the table is a flat,
+//      linearly probed array of node ids, each tagged with the full
+//      hash of its cofactors so most mismatches are rejected without
+//      touching the node. With UNIQ_CHAINED it is an array of chain
+//      heads and collisions are chained through the nodes' next
+//      fields. When the manager is made with incrUniq set, a resize of
+//      an open-addressed table keeps the old array and moves a few of
+//      its slots to the new one on each findOrAdd() rather than all at
+//      once. Until the move is done, lookups that miss in the new
+//      array also probe the old one. During a parallel operation
+//      findOrAddShared() is used instead: the table is made ready by
+//      prepareShared() before the workers start or while they are
+//      paused, and new nodes are published with a compare and swap.
 class UniqTbl {
  public:
-  UniqTbl();
+  UniqTbl(bool chained = false);
   ~UniqTbl() {
   };
 
-  size_t size() const { return _size; };
+  size_t size() const;
   size_t numNodes() const { return _numNodes; };
 
   BDD findOrAdd(BddImpl &impl,
                 int index,
                 BDD hi,
                 BDD lo);
+  BDD findOrAddShared(BddImpl &impl,
+                      BDDVec &spare,
+                      int index,
+                      BDD hi,
+                      BDD lo);
+  bool prepareShared(BddImpl &impl);
+  void prefetch(BDD hi, BDD lo) const;
   void resize(BddImpl &impl);
   BDD getHash(size_t hdx) const;
-  void putHash(BddImpl &impl,
-               BDD f,
-               size_t hdx);
   void putHash(BddImpl &impl,
                BDD f);
 
-  size_t getMask() { return _mask; };
-
   void clear(BddImpl &impl, BDDVec &nodes);
+  void shrink(size_t numNodes);
+  void reset();
   void setProcessed(bool b) { _processed = b; };
   bool processed() const { return _processed; };
 
   void freeTbl() {
-    delete [] _tbl;
+    std::free(_tbl);
     _tbl = nullptr;
+    std::free(_old);
+    _old = nullptr;
+    delete [] _heads;
+    _heads = nullptr;
   }; // freeTbl
 
  private:
-  BDD *_tbl;
+  size_t fitSize(size_t numNodes) const;
+  void allocTbl(size_t size);
+  bool allocated() const { return _tbl || _heads; };
+
+  struct Slot {
+    BDD _f;
+    uint32_t _hash;
+  }; // Slot
+  void putSlot(BDD f, uint32_t hash);
+
+  // Slot arrays come from calloc() so that the pages of a large new
+  // array are zeroed by the OS as they are first touched rather than
+  // all at once by the resize.
+  static Slot *allocSlots(size_t n) {
+    return static_cast<Slot *>(std::calloc(n, sizeof(Slot)));
+  }; // allocSlots
+
+  BDD findOld(BddImpl &impl,
+              uint32_t hash,
+              BDD hi,
+              BDD lo) const;
+  void migrate(size_t numSlots);
+
+  // The chained table. See UniqTbls.cc.
+  BDD findOrAddChained(BddImpl &impl,
+                       int index,
+                       BDD hi,
+                       BDD lo);
+  BDD findOrAddSharedChained(BddImpl &impl,
+                             BDDVec &spare,
+                             int index,
+                             BDD hi,
+                             BDD lo);
+  void resizeChained(BddImpl &impl);
+  void putHash(BddImpl &impl,
+               BDD f,
+               size_t hdx);
+  void clearChained(BddImpl &impl, BDDVec &nodes);
+
+  // The slot array of an open-addressed table and the array being
+  // moved out of during an incremental resize.
+  Slot *_tbl;
+  Slot *_old;
+  size_t _oldSize;
+  size_t _migrated;
+
+  // The chain heads of a chained table.
+  BDD *_heads;
+
   size_t _size;
   size_t _mask;
   size_t _numNodes;
+  bool _chained:1;
   bool _processed:1;
 }; // UniqTbl
 
@@ -69,7 +140,7 @@ class UniqTbls {
   UniqTbls(UniqTbls &&) = delete; // Move CTOR
   UniqTbls &operator=(UniqTbls &&) = delete; // Move assignment
 
-  void resize(size_t nuSize) { _tables.resize(nuSize); };
+  void resize(size_t nuSize);
   UniqTbl & operator[](size_t idx) { return _tables[idx]; };
   auto begin() { return _tables.begin(); };
   auto end() { return _tables.end(); };